@@ -1,163 +1,163 @@
-#ifndef SHADER_H
-#define SHADER_H
-
-#include <glad/glad.h>
-#include "shader_def.h"
-
-#include <string>
-#include <fstream>
-#include <sstream>
-#include <iostream>
-
-
-class Shader {
-
-public:
-	// program ID
-	unsigned int ID;
-
-	// constructor reads and builds the shader
-	Shader(const char* vertexPath, const char* fragmentPath) {
-
-		// retrieve the vertex, fragment source code from filepath
-		std::string		vertexCode;
-		std::string		fragmentCode;
-		std::ifstream	vShaderFile;
-		std::ifstream	fShaderFile;
-
-		// check and throw exeptions
-		// perform checksum
-		vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-		fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-
-		try {
-			// open file
-			vShaderFile.open(vertexPath);
-			fShaderFile.open(fragmentPath);
-			std::stringstream vShaderStream, fShaderStream;
-
-			// read buffer content to stream
-			vShaderStream << vShaderFile.rdbuf();
-			fShaderStream << fShaderFile.rdbuf();
-
-			// close file handlers
-			vShaderFile.close();
-			fShaderFile.close();
-
-			// convert stream to string
-			vertexCode = vShaderStream.str();
-			fragmentCode = fShaderStream.str();
-		}
-
-		catch (std::ifstream::failure e) {
-			std::cout << "ERROR::SHADER::READ_FILE_FAILURE" << e.what() <<std::endl;
-		}
-
-		const char* vShaderCode = vertexCode.c_str();
-		const char* fShaderCode = fragmentCode.c_str();
-
-		// activate the Shader
-
-		unsigned int vertex, fragment;
-		
-		vertex = glCreateShader(GL_VERTEX_SHADER);
-		glShaderSource(vertex, 1, &vShaderCode, NULL);
-		glCompileShader(vertex);
-		compileCheck(vertex, "VERTEX");
-		
-
-		fragment = glCreateShader(GL_FRAGMENT_SHADER);
-		glShaderSource(fragment, 1, &fShaderCode, NULL);
-		glCompileShader(fragment);
-		compileCheck(fragment, "FRAGMENT");
-
-		ID = glCreateProgram();
-		glAttachShader(ID, vertex);
-		glAttachShader(ID, fragment);
-		glLinkProgram(ID);
-		compileCheck(ID, "PROGRAM");
-
-		glDeleteShader(vertex);
-		glDeleteShader(fragment);
-		
-	}
-	
-	void use() {
-		glUseProgram(ID);
-	}
-
-	void setBool(const std::string &name, bool value) const {
-		glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
-	}
-
-	void setInt(const std::string &name, int value) const {
-		glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
-	}
-
-	void setFloat(const std::string &name, float value) const {
-		glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
-	}
-
-	// ------------------------------------------------------------------------
-	void setVec2(const std::string& name, const glm::vec2& value) const {
-		glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
-	}
-	void setVec2(const std::string& name, float x, float y) const {
-		glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
-	}
-	// ------------------------------------------------------------------------
-	void setVec3(const std::string& name, const glm::vec3& value) const {
-		glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
-	}
-	void setVec3(const std::string& name, float x, float y, float z) const {
-		glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
-	}
-	// ------------------------------------------------------------------------
-	void setVec4(const std::string& name, const glm::vec4& value) const {
-		glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
-	}
-	void setVec4(const std::string& name, float x, float y, float z, float w) const {
-		glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
-	}
-	// ------------------------------------------------------------------------
-	void setMat2(const std::string& name, const glm::mat2& mat) const {
-		glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
-	}
-	// ------------------------------------------------------------------------
-	void setMat3(const std::string& name, const glm::mat3& mat) const {
-		glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
-	}
-	// ------------------------------------------------------------------------
-	void setMat4(const std::string& name, const glm::mat4& mat) const {
-		glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
-	}
-
-
-	private:
-		void compileCheck(unsigned int shader, std::string type) {
-			int success;
-			char infoLog[1024];
-
-			if (type != "PROGRAM") {
-				glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-
-				if (!success) {
-					glGetShaderInfoLog(shader, 1024, NULL, infoLog);
-					std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << type <<
-						"\n" << infoLog << std::endl;
-				};
-			}
-			else {
-				glGetProgramiv(shader, GL_LINK_STATUS, &success);
-
-				if (!success) {
-					glGetProgramInfoLog(ID, 1024, NULL, infoLog);
-					std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << type <<
-						"\n" << infoLog <<std::endl;
-				}
-			}
-		}
-
-};
-
+#ifndef SHADER_H
+#define SHADER_H
+
+#include <glad/glad.h>
+#include "shader_def.h"
+
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+
+
+class Shader {
+
+public:
+	// program ID
+	unsigned int ID;
+
+	// constructor reads and builds the shader
+	Shader(const char* vertexPath, const char* fragmentPath) {
+
+		// retrieve the vertex, fragment source code from filepath
+		std::string		vertexCode;
+		std::string		fragmentCode;
+		std::ifstream	vShaderFile;
+		std::ifstream	fShaderFile;
+
+		// check and throw exeptions
+		// perform checksum
+		vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+		fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+
+		try {
+			// open file
+			vShaderFile.open(vertexPath);
+			fShaderFile.open(fragmentPath);
+			std::stringstream vShaderStream, fShaderStream;
+
+			// read buffer content to stream
+			vShaderStream << vShaderFile.rdbuf();
+			fShaderStream << fShaderFile.rdbuf();
+
+			// close file handlers
+			vShaderFile.close();
+			fShaderFile.close();
+
+			// convert stream to string
+			vertexCode = vShaderStream.str();
+			fragmentCode = fShaderStream.str();
+		}
+
+		catch (std::ifstream::failure e) {
+			std::cout << "ERROR::SHADER::READ_FILE_FAILURE" << e.what() <<std::endl;
+		}
+
+		const char* vShaderCode = vertexCode.c_str();
+		const char* fShaderCode = fragmentCode.c_str();
+
+		// activate the Shader
+
+		unsigned int vertex, fragment;
+		
+		vertex = glCreateShader(GL_VERTEX_SHADER);
+		glShaderSource(vertex, 1, &vShaderCode, NULL);
+		glCompileShader(vertex);
+		compileCheck(vertex, "VERTEX");
+		
+
+		fragment = glCreateShader(GL_FRAGMENT_SHADER);
+		glShaderSource(fragment, 1, &fShaderCode, NULL);
+		glCompileShader(fragment);
+		compileCheck(fragment, "FRAGMENT");
+
+		ID = glCreateProgram();
+		glAttachShader(ID, vertex);
+		glAttachShader(ID, fragment);
+		glLinkProgram(ID);
+		compileCheck(ID, "PROGRAM");
+
+		glDeleteShader(vertex);
+		glDeleteShader(fragment);
+		
+	}
+	
+	void use() {
+		glUseProgram(ID);
+	}
+
+	void setBool(const std::string &name, bool value) const {
+		glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+	}
+
+	void setInt(const std::string &name, int value) const {
+		glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+	}
+
+	void setFloat(const std::string &name, float value) const {
+		glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+	}
+
+	// ------------------------------------------------------------------------
+	void setVec2(const std::string& name, const glm::vec2& value) const {
+		glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+	}
+	void setVec2(const std::string& name, float x, float y) const {
+		glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
+	}
+	// ------------------------------------------------------------------------
+	void setVec3(const std::string& name, const glm::vec3& value) const {
+		glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+	}
+	void setVec3(const std::string& name, float x, float y, float z) const {
+		glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
+	}
+	// ------------------------------------------------------------------------
+	void setVec4(const std::string& name, const glm::vec4& value) const {
+		glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
+	}
+	void setVec4(const std::string& name, float x, float y, float z, float w) const {
+		glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
+	}
+	// ------------------------------------------------------------------------
+	void setMat2(const std::string& name, const glm::mat2& mat) const {
+		glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+	}
+	// ------------------------------------------------------------------------
+	void setMat3(const std::string& name, const glm::mat3& mat) const {
+		glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+	}
+	// ------------------------------------------------------------------------
+	void setMat4(const std::string& name, const glm::mat4& mat) const {
+		glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+	}
+
+
+	private:
+		void compileCheck(unsigned int shader, std::string type) {
+			int success;
+			char infoLog[1024];
+
+			if (type != "PROGRAM") {
+				glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+
+				if (!success) {
+					glGetShaderInfoLog(shader, 1024, NULL, infoLog);
+					std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << type <<
+						"\n" << infoLog << std::endl;
+				};
+			}
+			else {
+				glGetProgramiv(shader, GL_LINK_STATUS, &success);
+
+				if (!success) {
+					glGetProgramInfoLog(ID, 1024, NULL, infoLog);
+					std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << type <<
+						"\n" << infoLog <<std::endl;
+				}
+			}
+		}
+
+};
+
 #endif
\ No newline at end of file
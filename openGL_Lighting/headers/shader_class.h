@@ -1,154 +1,353 @@
-#ifndef SHADER_H
-#define SHADER_H
-
-#include <glad/glad.h>
-
-#include <string>
-#include <fstream>
-#include <sstream>
-#include "iostream"
-
-
-class Shader {
-public:
-
-	GLuint ID; //shader ID
-
-	Shader(const char* vertexShaderPath, const char* fragmentShaderPath) {   
-		std::string vertexCode, fragmentCode;	
-		std::ifstream vShaderFile, fShaderFile;
-
-		// try and perform checksum on shader files
-		vShaderFile.exceptions(std::ifstream::failbit || std::ifstream::badbit);
-		fShaderFile.exceptions(std::ifstream::failbit || std::ifstream::badbit);
-
-		// read the shader files as streams
-		try {
-			vShaderFile.open(vertexShaderPath);
-			fShaderFile.open(fragmentShaderPath);
-			std::stringstream vShaderStream, fShaderStream;
-
-			// read the buffer of shader files into stringstreams
-			vShaderStream << vShaderFile.rdbuf();
-			fShaderStream << fShaderFile.rdbuf();
-
-			// close the files after reading
-			vShaderFile.close();
-			fShaderFile.close();
-
-			// convert the code file to strings
-			vertexCode		= vShaderStream.str();
-			fragmentCode	= fShaderStream.str();
-		}
-		
-		catch(std::ifstream::failure error ){
-			std::cout << "Failed to read shader file" << error.what() << std::endl;
-		}
-
-		// convert the code strings to C- strings
-		const char* vShaderCode = vertexCode.c_str();
-		 const char* fShaderCode = fragmentCode.c_str();
-
-		// Create vertex and fragment shader from definition C-string code
-		unsigned int vertex, fragment;
-
-		vertex = glCreateShader(GL_VERTEX_SHADER);
-		glShaderSource(vertex, 1, &vShaderCode, NULL);
-		glCompileShader(vertex);
-		compileCheck(vertex, "VERTEX");
-
-		fragment = glCreateShader(GL_FRAGMENT_SHADER);
-		glShaderSource(fragment, 1, &fShaderCode, NULL);
-		glCompileShader(fragment);
-		compileCheck(fragment, "FRAGMENT");
-
-		ID = glCreateProgram();
-		glAttachShader(ID, vertex);
-		glAttachShader(ID, fragment);
-		glLinkProgram(ID);
-		compileCheck(ID, "PROGRAM");
-
-
-		// Delete shaders after linking to free up memory
-		glDeleteShader(vertex);
-		glDeleteShader(fragment);
-
-	}
-
-	void use() {
-		glUseProgram(ID);
-	}
-
-	// set Values for variables in vertex and fragment shaders
-
-	void setBool(const std::string &name, bool value) const {
-		glUniform1i(glGetUniformLocation(ID, name.c_str()), (int) value);
-	}
-
-	void setInt(const std::string &name, int value) const {
-		glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
-	}
-
-	void setFloat(const std::string& name, float value) const {
-		glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
-	}
-
-	// set values for uniform in vertex and fragmenmt shaders
-	void setVec2(const std::string& name, const glm::vec2& value) const {
-		glUniform2fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
-	}
-	void setVec2(const std::string& name, float x, float y) const {
-		glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
-	}
-	// ------------------------------------------------------------------------
-	void setVec3(const std::string& name, const glm::vec3& value) const {
-		glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
-	}
-	void setVec3(const std::string& name, float x, float y, float z) const {
-		glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
-	}
-	// ------------------------------------------------------------------------
-	void setVec4(const std::string& name, const glm::vec4& value) const {
-		glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, &value[0]);
-	}
-	void setVec4(const std::string& name, float x, float y, float z, float w) const {
-		glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
-	}
-	// ------------------------------------------------------------------------
-	void setMat2(const std::string& name, const glm::mat2& mat) const {
-		glUniformMatrix2fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
-	}
-	// ------------------------------------------------------------------------
-	void setMat3(const std::string& name, const glm::mat3& mat) const {
-		glUniformMatrix3fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
-	}
-	// ------------------------------------------------------------------------
-	void setMat4(const std::string& name, const glm::mat4& mat) const {
-		glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
-	}
-
-private:
-	void compileCheck(GLuint shader, std::string type) {
-		int success;
-		char infoLog[1024];
-
-		if (type != "PROGRAM") {
-			glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-			if (!success) {
-				glGetShaderInfoLog(shader, 1024, NULL, infoLog);
-				std::cout << "ERROR::SHADER::COMPILATION_FAILED\n" << type <<
-					"\n" << infoLog << std::endl;
-			};
-		}
-		else {
-			glGetProgramiv(shader, GL_LINK_STATUS, &success);
-			if (!success) {
-				glGetProgramInfoLog(ID, 1024, NULL, infoLog);
-				std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << type <<
-					"\n" << infoLog << std::endl;
-			}
-		}
-	}
-};
-
-#endif // !SHADER_H
+#ifndef SHADER_H
+#define SHADER_H
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "iostream"
+
+// FNV-1a of a uniform name, constexpr so names written in the source can be hashed by the compiler
+constexpr uint32_t uniformHash(const char* name) {
+	uint32_t hash = 2166136261u;
+	for (; *name != '\0'; name++) hash = (hash ^ static_cast<unsigned char>(*name)) * 16777619u;
+	return hash;
+}
+
+// handle a uniform is looked up by. Only a constexpr UniformName is guaranteed to be hashed at compile time,
+// a literal passed straight to a setter is hashed on every call, so hot paths keep their names in constants.
+// Built names are hashed when converted
+struct UniformName {
+	uint32_t hash;
+	const char* text;	// compared against the reflected name, only valid as long as the name it came from
+	bool stable;		// text outlives the Shader (literals and constants), its check is remembered
+
+	constexpr UniformName(const char* name) : hash(uniformHash(name)), text(name), stable(true) {}
+	UniformName(const std::string& name) : hash(uniformHash(name.c_str())), text(name.c_str()), stable(false) {}
+};
+
+// uploads a Shader's setters made since the last reset
+struct UniformUploadStats {
+	unsigned long long submitted = 0;	// changed values that went to GL
+	unsigned long long skipped = 0;		// bit-identical to what the program already held
+};
+
+
+class Shader {
+public:
+
+	GLuint ID; //shader ID
+
+	Shader(const char* vertexShaderPath, const char* fragmentShaderPath) {   
+		std::string vertexCode, fragmentCode;	
+		std::ifstream vShaderFile, fShaderFile;
+
+		// try and perform checksum on shader files
+		vShaderFile.exceptions(std::ifstream::failbit || std::ifstream::badbit);
+		fShaderFile.exceptions(std::ifstream::failbit || std::ifstream::badbit);
+
+		// read the shader files as streams
+		try {
+			vShaderFile.open(vertexShaderPath);
+			fShaderFile.open(fragmentShaderPath);
+			std::stringstream vShaderStream, fShaderStream;
+
+			// read the buffer of shader files into stringstreams
+			vShaderStream << vShaderFile.rdbuf();
+			fShaderStream << fShaderFile.rdbuf();
+
+			// close the files after reading
+			vShaderFile.close();
+			fShaderFile.close();
+
+			// convert the code file to strings
+			vertexCode		= vShaderStream.str();
+			fragmentCode	= fShaderStream.str();
+		}
+		
+		catch(std::ifstream::failure error ){
+			std::cout << "Failed to read shader file" << error.what() << std::endl;
+		}
+
+		// convert the code strings to C- strings
+		const char* vShaderCode = vertexCode.c_str();
+		 const char* fShaderCode = fragmentCode.c_str();
+
+		// Create vertex and fragment shader from definition C-string code
+		unsigned int vertex, fragment;
+
+		vertex = glCreateShader(GL_VERTEX_SHADER);
+		glShaderSource(vertex, 1, &vShaderCode, NULL);
+		glCompileShader(vertex);
+		compileCheck(vertex, "VERTEX");
+
+		fragment = glCreateShader(GL_FRAGMENT_SHADER);
+		glShaderSource(fragment, 1, &fShaderCode, NULL);
+		glCompileShader(fragment);
+		compileCheck(fragment, "FRAGMENT");
+
+		ID = glCreateProgram();
+		glAttachShader(ID, vertex);
+		glAttachShader(ID, fragment);
+		glLinkProgram(ID);
+		compileCheck(ID, "PROGRAM");
+
+
+		// Delete shaders after linking to free up memory
+		glDeleteShader(vertex);
+		glDeleteShader(fragment);
+
+		reflect();
+	}
+
+	void use() {
+		glUseProgram(ID);
+	}
+
+	// location of an active uniform, -1 when the program has none by that name. Nothing is reported
+	GLint location(const UniformName& name) const {
+		const TableSlot* slot = findSlot(uniformTable, name);
+		return slot ? slot->value : -1;
+	}
+
+	// index of an active uniform block, GL_INVALID_INDEX when there is none by that name
+	GLuint uniformBlock(const UniformName& name) const {
+		const TableSlot* slot = findSlot(blockTable, name);
+		return slot ? static_cast<GLuint>(slot->value) : GL_INVALID_INDEX;
+	}
+
+	// the setters remember the last value of every uniform and skip the GL call when it is set again
+	// unchanged. Values written with glUniform on a location() bypass that, forget them afterwards
+	const UniformUploadStats& uploadStats() const { return uploads; }
+	void resetUploadStats() { uploads = UniformUploadStats(); }
+	void forgetUniformValues() { std::fill(shadows.begin(), shadows.end(), UniformShadow()); }
+
+	// set Values for variables in vertex and fragment shaders, the program has to be in use
+
+	void setBool(const UniformName& name, bool value) const {
+		setInt(name, (int) value);
+	}
+
+	void setInt(const UniformName& name, int value) const {
+		GLint location;
+		if (changed(name, &value, sizeof(value), location)) glUniform1i(location, value);
+	}
+
+	void setFloat(const UniformName& name, float value) const {
+		GLint location;
+		if (changed(name, &value, sizeof(value), location)) glUniform1f(location, value);
+	}
+
+	// set values for uniform in vertex and fragmenmt shaders
+	void setVec2(const UniformName& name, const glm::vec2& value) const {
+		GLint location;
+		if (changed(name, &value[0], sizeof(value), location)) glUniform2fv(location, 1, &value[0]);
+	}
+	void setVec2(const UniformName& name, float x, float y) const {
+		setVec2(name, glm::vec2(x, y));
+	}
+	// ------------------------------------------------------------------------
+	void setVec3(const UniformName& name, const glm::vec3& value) const {
+		GLint location;
+		if (changed(name, &value[0], sizeof(value), location)) glUniform3fv(location, 1, &value[0]);
+	}
+	void setVec3(const UniformName& name, float x, float y, float z) const {
+		setVec3(name, glm::vec3(x, y, z));
+	}
+	// ------------------------------------------------------------------------
+	void setVec4(const UniformName& name, const glm::vec4& value) const {
+		GLint location;
+		if (changed(name, &value[0], sizeof(value), location)) glUniform4fv(location, 1, &value[0]);
+	}
+	void setVec4(const UniformName& name, float x, float y, float z, float w) const {
+		setVec4(name, glm::vec4(x, y, z, w));
+	}
+	// ------------------------------------------------------------------------
+	void setMat2(const UniformName& name, const glm::mat2& mat) const {
+		GLint location;
+		if (changed(name, &mat[0][0], sizeof(mat), location)) glUniformMatrix2fv(location, 1, GL_FALSE, &mat[0][0]);
+	}
+	// ------------------------------------------------------------------------
+	void setMat3(const UniformName& name, const glm::mat3& mat) const {
+		GLint location;
+		if (changed(name, &mat[0][0], sizeof(mat), location)) glUniformMatrix3fv(location, 1, GL_FALSE, &mat[0][0]);
+	}
+	// ------------------------------------------------------------------------
+	void setMat4(const UniformName& name, const glm::mat4& mat) const {
+		GLint location;
+		if (changed(name, &mat[0][0], sizeof(mat), location)) glUniformMatrix4fv(location, 1, GL_FALSE, &mat[0][0]);
+	}
+
+private:
+	// open addressing on the name hash, a power of two at least twice the entries so probes stay short.
+	// reflect reports the rare program where two active names share a hash
+	struct TableSlot {
+		uint32_t hash = 0;
+		GLint value = -1;
+		uint32_t shadow = 0;	// uniforms only, names of the same location share their shadow
+		bool used = false;
+		std::string name;
+		mutable const char* verified = nullptr;	// stable text already found equal to name
+	};
+
+	// last value a setter sent to a location. Sized for a mat4, the largest setter
+	struct UniformShadow {
+		unsigned char data[sizeof(float) * 16];
+		size_t bytes = 0;	// 0 until the first set
+	};
+
+	struct ReflectedName {
+		uint32_t hash;
+		GLint value;
+		std::string name;
+	};
+
+	std::vector<TableSlot> uniformTable;
+	std::vector<TableSlot> blockTable;
+	mutable std::vector<std::string> reportedNames;	// unknown names already printed
+	mutable std::vector<UniformShadow> shadows;
+	mutable UniformUploadStats uploads;
+
+	// an equal hash could still be another name, the text is compared unless the same stable text already was
+	static const TableSlot* findSlot(const std::vector<TableSlot>& table, const UniformName& name) {
+		if (table.empty()) return nullptr;
+		size_t mask = table.size() - 1;
+		for (size_t i = name.hash & mask; table[i].used; i = (i + 1) & mask) {
+			if (table[i].hash != name.hash) continue;
+			if (name.text == table[i].verified) return &table[i];
+			if (table[i].name != name.text) return nullptr;
+			if (name.stable) table[i].verified = name.text;
+			return &table[i];
+		}
+		return nullptr;
+	}
+
+	static std::vector<TableSlot> buildTable(std::vector<ReflectedName>& names) {
+		std::sort(names.begin(), names.end(), [](const ReflectedName& a, const ReflectedName& b) { return a.hash < b.hash; });
+		for (size_t i = 1; i < names.size(); i++) {
+			if (names[i].hash == names[i - 1].hash && names[i].name != names[i - 1].name) {
+				std::cout << "ERROR::SHADER::UNIFORM_HASH_COLLISION: " << names[i - 1].name << " and " << names[i].name << std::endl;
+			}
+		}
+
+		size_t size = 1;
+		while (size < names.size() * 2) size <<= 1;
+		std::vector<TableSlot> table(size);
+		for (const ReflectedName& entry : names) {
+			size_t i = entry.hash & (size - 1);
+			while (table[i].used && table[i].hash != entry.hash) i = (i + 1) & (size - 1);
+			if (table[i].used) continue;	// first of a collision wins
+			table[i].hash = entry.hash;
+			table[i].value = entry.value;
+			table[i].used = true;
+			table[i].name = entry.name;
+		}
+		return table;
+	}
+
+	// every active uniform and block once after linking, the setters never ask GL for a location again
+	void reflect() {
+		std::vector<ReflectedName> uniforms;
+		GLint count = 0, maxLength = 0;
+		glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+		glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+		std::vector<GLchar> buffer(std::max(maxLength, 1));
+		for (GLint i = 0; i < count; i++) {
+			GLsizei length = 0;
+			GLint size = 0;
+			GLenum type = 0;
+			glGetActiveUniform(ID, static_cast<GLuint>(i), static_cast<GLsizei>(buffer.size()), &length, &size, &type, buffer.data());
+			std::string name(buffer.data(), length);
+			GLint location = glGetUniformLocation(ID, name.c_str());
+			if (location < 0) continue;	// member of a uniform block, set through its buffer
+			uniforms.push_back({ uniformHash(name.c_str()), location, name });
+
+			// arrays are listed once as name[0], the bare name means element 0 and the others get their own locations
+			if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) {
+				std::string base = name.substr(0, name.size() - 3);
+				uniforms.push_back({ uniformHash(base.c_str()), location, base });
+				for (GLint element = 1; element < size; element++) {
+					std::string elementName = base + '[' + std::to_string(element) + ']';
+					uniforms.push_back({ uniformHash(elementName.c_str()), glGetUniformLocation(ID, elementName.c_str()), elementName });
+				}
+			}
+		}
+		uniformTable = buildTable(uniforms);
+		// bones and bones[0] are one location, a value set through either is the same value
+		std::vector<GLint> shadowLocations;
+		for (TableSlot& slot : uniformTable) {
+			if (!slot.used) continue;
+			auto found = std::find(shadowLocations.begin(), shadowLocations.end(), slot.value);
+			slot.shadow = static_cast<uint32_t>(found - shadowLocations.begin());
+			if (found == shadowLocations.end()) shadowLocations.push_back(slot.value);
+		}
+		shadows.assign(shadowLocations.size(), UniformShadow());
+
+		std::vector<ReflectedName> blocks;
+		count = 0;
+		maxLength = 0;
+		glGetProgramiv(ID, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+		glGetProgramiv(ID, GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &maxLength);
+		buffer.assign(std::max(maxLength, 1), '\0');
+		for (GLint i = 0; i < count; i++) {
+			GLsizei length = 0;
+			glGetActiveUniformBlockName(ID, static_cast<GLuint>(i), static_cast<GLsizei>(buffer.size()), &length, buffer.data());
+			std::string name(buffer.data(), length);
+			blocks.push_back({ uniformHash(name.c_str()), i, name });
+		}
+		blockTable = buildTable(blocks);
+	}
+
+	// true when value has to go to GL, the shadow then holds it. Names the program doesn't have are
+	// printed the first time they are set, GL would ignore them silently
+	bool changed(const UniformName& name, const void* value, size_t bytes, GLint& location) const {
+		const TableSlot* slot = findSlot(uniformTable, name);
+		if (!slot) {
+			if (std::find(reportedNames.begin(), reportedNames.end(), name.text) == reportedNames.end()) {
+				reportedNames.push_back(name.text);
+				std::cout << "ERROR::SHADER::UNKNOWN_UNIFORM: " << name.text << " is not an active uniform of program " << ID << std::endl;
+			}
+			return false;
+		}
+
+		UniformShadow& shadow = shadows[slot->shadow];
+		if (shadow.bytes == bytes && std::memcmp(shadow.data, value, bytes) == 0) {
+			uploads.skipped++;
+			return false;
+		}
+		std::memcpy(shadow.data, value, bytes);
+		shadow.bytes = bytes;
+		uploads.submitted++;
+		location = slot->value;
+		return true;
+	}
+
+	void compileCheck(GLuint shader, std::string type) {
+		int success;
+		char infoLog[1024];
+
+		if (type != "PROGRAM") {
+			glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+			if (!success) {
+				glGetShaderInfoLog(shader, 1024, NULL, infoLog);
+				std::cout << "ERROR::SHADER::COMPILATION_FAILED\n" << type <<
+					"\n" << infoLog << std::endl;
+			};
+		}
+		else {
+			glGetProgramiv(shader, GL_LINK_STATUS, &success);
+			if (!success) {
+				glGetProgramInfoLog(ID, 1024, NULL, infoLog);
+				std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << type <<
+					"\n" << infoLog << std::endl;
+			}
+		}
+	}
+};
+
+#endif // !SHADER_H
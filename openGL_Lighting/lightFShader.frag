@@ -1,10 +1,10 @@
-#version 330 core
-
-out vec4 FragColor;
-
-uniform vec4 lampColor;
-
-void main(){
-	//FragColor = vec4(1.0);
-	FragColor = lampColor;
+#version 330 core
+
+out vec4 FragColor;
+
+uniform vec4 lampColor;
+
+void main(){
+	//FragColor = vec4(1.0);
+	FragColor = lampColor;
 }
\ No newline at end of file
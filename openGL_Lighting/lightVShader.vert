@@ -1,12 +1,20 @@
-#version 330 core
-layout (location = 0) in vec3 aPos;
-
-
-uniform mat4 model;
-uniform mat4 viewMat;
-uniform mat4 projectMat;
-
-
-void main() {
-	gl_Position = projectMat * viewMat * model * vec4(aPos, 1.0);
+#version 330 core
+layout (location = 0) in vec3 aPos;
+
+
+// shared by every program, CAMERA_BLOCK_BINDING in uniform_buffer.h
+layout (std140) uniform Camera {
+	mat4 view;
+	mat4 projection;
+	vec4 cameraPosition;
+};
+// this draw's slice of the uniform ring, OBJECT_BLOCK_BINDING
+layout (std140) uniform Object {
+	mat4 model;
+	mat4 normalMat;
+};
+
+
+void main() {
+	gl_Position = projection * view * model * vec4(aPos, 1.0);
 }
\ No newline at end of file
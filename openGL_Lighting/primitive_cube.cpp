@@ -1 +1 @@
-#include "primitive_cube.h"
+#include "primitive_cube.h"
@@ -0,0 +1,51 @@
+#include "texture_loader.h"
+#include "thread_pool.h"
+#include "stb_image.h"
+
+#include <iostream>
+
+DecodedImage::~DecodedImage() {
+	if (pixels) stbi_image_free(pixels);
+}
+
+std::shared_ptr<DecodedImage> decodeImage(const std::string& path, bool flipVertically) {
+	std::shared_ptr<DecodedImage> image = std::make_shared<DecodedImage>();
+	image->path = path;
+
+	// the flip flag is per thread so concurrent decodes don't fight over it
+	stbi_set_flip_vertically_on_load_thread(flipVertically);
+	image->pixels = stbi_load(path.c_str(), &image->width, &image->height, &image->channels, 0);
+	return image;
+}
+
+DecodedImageFuture decodeImageAsync(const std::string& path, bool flipVertically) {
+	return ThreadPool::shared().submit([path, flipVertically]() { return decodeImage(path, flipVertically); }).share();
+}
+
+unsigned int uploadImageTexture(const DecodedImage& image, const TextureSampling& sampling) {
+	unsigned int textureID;
+	glGenTextures(1, &textureID);
+
+	if (image.pixels) {
+		GLenum format = GL_RGB;
+		if (image.channels == 1) format = GL_RED;
+		else if (image.channels == 3) format = GL_RGB;
+		else if (image.channels == 4) format = GL_RGBA;
+
+		glBindTexture(GL_TEXTURE_2D, textureID);
+
+		glTexImage2D(GL_TEXTURE_2D, 0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, image.pixels);
+		glGenerateMipmap(GL_TEXTURE_2D);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, sampling.wrap);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, sampling.wrap);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, sampling.minFilter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, sampling.magFilter);
+	}
+	else {
+		std::cout << "Texture load unsuccesfully at: " << image.path << std::endl;
+	}
+
+	return textureID;
+}
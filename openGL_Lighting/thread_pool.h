@@ -0,0 +1,54 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Fixed size pool of worker threads consuming a FIFO of tasks.
+// Workers never touch the GL context, only CPU side work should be submitted
+class ThreadPool {
+public:
+	// 0 threads means one per hardware core
+	explicit ThreadPool(unsigned int threadCount = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// process wide pool shared by the loaders
+	static ThreadPool& shared();
+
+	unsigned int size() const { return static_cast<unsigned int>(workers.size()); }
+
+	template <typename F>
+	auto submit(F&& task) -> std::future<decltype(task())> {
+		using Result = decltype(task());
+		auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+		std::future<Result> result = packaged->get_future();
+		enqueue([packaged]() { (*packaged)(); });
+		return result;
+	}
+
+	// run body(i) for every i in [0, count), blocks until all of them are done.
+	// The calling thread works on the range as well, so it is safe to call from inside a task.
+	// The first exception body throws is rethrown here once the whole range is done
+	void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+private:
+	std::vector<std::thread> workers;
+	std::queue<std::function<void()>> tasks;
+	std::mutex queueMutex;
+	std::condition_variable queueCondition;
+	bool stopping = false;
+
+	void enqueue(std::function<void()> task);
+	void workerLoop();
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include "uniform_buffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+void bindUniformBlocks(const Shader& shader) {
+	GLuint camera = shader.uniformBlock("Camera");
+	if (camera != GL_INVALID_INDEX) glUniformBlockBinding(shader.ID, camera, CAMERA_BLOCK_BINDING);
+	GLuint object = shader.uniformBlock("Object");
+	if (object != GL_INVALID_INDEX) glUniformBlockBinding(shader.ID, object, OBJECT_BLOCK_BINDING);
+}
+
+UniformRing::UniformRing(size_t bytesPerFrame) {
+	GLint offsetAlignment = 0;
+	glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+	if (offsetAlignment > 0) alignment = static_cast<size_t>(offsetAlignment);
+	allocate(bytesPerFrame);
+}
+
+UniformRing::~UniformRing() {
+	release();
+}
+
+void UniformRing::release() {
+	for (GLsync& fence : fences) {
+		if (fence) glDeleteSync(fence);
+		fence = 0;
+	}
+	if (buffer) glDeleteBuffers(1, &buffer);
+	buffer = 0;
+}
+
+void UniformRing::allocate(size_t bytesPerFrame) {
+	// regions start on the offset alignment, so every block offset inside them is aligned too
+	frameBytes = (bytesPerFrame + alignment - 1) / alignment * alignment;
+
+	if (!buffer) glGenBuffers(1, &buffer);
+	glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+	glBufferData(GL_UNIFORM_BUFFER, frameBytes * UNIFORM_RING_FRAMES, nullptr, GL_STREAM_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	// fresh storage, draws still in flight keep reading the old one
+	for (GLsync& fence : fences) {
+		if (fence) glDeleteSync(fence);
+		fence = 0;
+	}
+	counters.capacity = frameBytes;
+}
+
+void UniformRing::beginFrame() {
+	frame = (frame + 1) % UNIFORM_RING_FRAMES;
+	staging.clear();
+	counters.bytes = 0;
+	counters.blocks = 0;
+	counters.orphaned = 0;
+
+	// with three regions the fence has nearly always passed. When it hasn't, waiting would stall
+	// on the GPU, orphaning the storage gives a free region right away
+	if (fences[frame]) {
+		if (glClientWaitSync(fences[frame], 0, 0) == GL_TIMEOUT_EXPIRED) {
+			allocate(frameBytes);
+			counters.orphaned++;
+		}
+		else {
+			glDeleteSync(fences[frame]);
+			fences[frame] = 0;
+		}
+	}
+}
+
+size_t UniformRing::push(const void* data, size_t bytes) {
+	size_t offset = (staging.size() + alignment - 1) / alignment * alignment;
+	staging.resize(offset + bytes);
+	std::memcpy(staging.data() + offset, data, bytes);
+	counters.blocks++;
+	return offset;
+}
+
+void UniformRing::upload() {
+	if (staging.empty()) return;
+
+	// a frame that outgrew its region gets new storage with room to spare
+	if (staging.size() > frameBytes) allocate(std::max(staging.size(), frameBytes * 2));
+
+	// the fence already said the GPU is done with the region, the driver has nothing to synchronize
+	glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+	GLintptr start = static_cast<GLintptr>(frame * frameBytes);
+	void* region = glMapBufferRange(GL_UNIFORM_BUFFER, start, static_cast<GLsizeiptr>(staging.size()), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+	if (region) {
+		std::memcpy(region, staging.data(), staging.size());
+		glUnmapBuffer(GL_UNIFORM_BUFFER);
+	}
+	else {
+		glBufferSubData(GL_UNIFORM_BUFFER, start, static_cast<GLsizeiptr>(staging.size()), staging.data());
+	}
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	counters.bytes = staging.size();
+}
+
+void UniformRing::bind(GLuint binding, size_t offset, size_t bytes) const {
+	glBindBufferRange(GL_UNIFORM_BUFFER, binding, buffer, static_cast<GLintptr>(frame * frameBytes + offset), static_cast<GLsizeiptr>(bytes));
+}
+
+void UniformRing::endFrame() {
+	if (fences[frame]) glDeleteSync(fences[frame]);
+	fences[frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
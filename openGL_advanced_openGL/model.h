@@ -1,53 +1,53 @@
-#ifndef MODEL_H
-#define MODEL_H
-
-
-#include <glad/glad.h>
-#include <GLFW/glfw3.h>
-
-#include <glm/glm/glm.hpp>
-#include <glm/glm/gtc/matrix_transform.hpp>
-#include <glm/glm/gtc/type_ptr.hpp>
-
-#include "shader_class.h"
-#include "camera_class.h"
-#include "stb_image.h"
-
-#include "mesh_data.h"
-
-// Assimp library for loading models
-#include <assimp/Importer.hpp>
-#include <assimp/scene.h>
-#include <assimp/postprocess.h>
-
-#include <string>
-#include <fstream>
-#include <sstream>
-#include <iostream>
-#include <map>
-#include <vector>
-class Model {
-public:
-	// constructor
-	std::vector<Mesh> meshes_list;
-	std::string directory;
-	std::vector<Texture> textures_loaded;
-	bool gammaCorrection;
-
-	Model(std::string const &path, bool gamma = false) : gammaCorrection(gamma) {
-		loadModel(path);
-	}
-	void Draw(Shader& shader);
-
-private:
-	
-	void loadModel(std::string const& path);
-	void processNode(aiNode* node, const aiScene* scene);
-	Mesh processMesh(aiMesh* mesh, const aiScene* scene);
-	std::vector<Texture> loadMaterialTextures(aiMaterial* mat, aiTextureType type, std::string typeName);
-	unsigned int TextureFromFile(const char* path, const std::string& directory, bool gamma = false);
-
-};
-
-#endif
-
+#ifndef MODEL_H
+#define MODEL_H
+
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm/glm.hpp>
+#include <glm/glm/gtc/matrix_transform.hpp>
+#include <glm/glm/gtc/type_ptr.hpp>
+
+#include "shader_class.h"
+#include "camera_class.h"
+#include "stb_image.h"
+
+#include "mesh_data.h"
+
+// Assimp library for loading models
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <map>
+#include <vector>
+class Model {
+public:
+	// constructor
+	std::vector<Mesh> meshes_list;
+	std::string directory;
+	std::vector<Texture> textures_loaded;
+	bool gammaCorrection;
+
+	Model(std::string const &path, bool gamma = false) : gammaCorrection(gamma) {
+		loadModel(path);
+	}
+	void Draw(Shader& shader);
+
+private:
+	
+	void loadModel(std::string const& path);
+	void processNode(aiNode* node, const aiScene* scene);
+	Mesh processMesh(aiMesh* mesh, const aiScene* scene);
+	std::vector<Texture> loadMaterialTextures(aiMaterial* mat, aiTextureType type, std::string typeName);
+	unsigned int TextureFromFile(const char* path, const std::string& directory, bool gamma = false);
+
+};
+
+#endif
+
@@ -1,7 +1,7 @@
-#version 330 core
-out vec4 FragColor;
-
-void main()
-{
-    FragColor = vec4(0.5, 0.5, 0.2, 1.0);
+#version 330 core
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vec4(0.5, 0.5, 0.2, 1.0);
 }
\ No newline at end of file
@@ -1,2 +1,2 @@
-#include "primitive_cube.h"
+#include "primitive_cube.h"
 #include "primitive_plane.h"
\ No newline at end of file
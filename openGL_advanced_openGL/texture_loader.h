@@ -0,0 +1,44 @@
+#ifndef TEXTURE_LOADER_H
+#define TEXTURE_LOADER_H
+
+#include <glad/glad.h>
+
+#include <future>
+#include <memory>
+#include <string>
+
+// pixels decoded by stb_image, freed together with the object
+struct DecodedImage {
+	std::string path;
+	unsigned char* pixels = nullptr;
+	int width = 0;
+	int height = 0;
+	int channels = 0;
+
+	DecodedImage() {}
+	~DecodedImage();
+
+	DecodedImage(const DecodedImage&) = delete;
+	DecodedImage& operator=(const DecodedImage&) = delete;
+};
+
+typedef std::shared_future<std::shared_ptr<DecodedImage>> DecodedImageFuture;
+
+// sampling state applied when the decoded pixels are uploaded
+struct TextureSampling {
+	GLint wrap = GL_REPEAT;
+	GLint minFilter = GL_NEAREST;
+	GLint magFilter = GL_NEAREST;
+};
+
+// decode an image file on the calling thread, any thread is fine
+std::shared_ptr<DecodedImage> decodeImage(const std::string& path, bool flipVertically = false);
+
+// queue the decode on the shared worker pool, the GL thread picks the pixels up with get()
+DecodedImageFuture decodeImageAsync(const std::string& path, bool flipVertically = false);
+
+// create a mipmapped GL texture from decoded pixels, GL thread only.
+// A texture name is returned even when decoding failed, like the old loaders did
+unsigned int uploadImageTexture(const DecodedImage& image, const TextureSampling& sampling = TextureSampling());
+
+#endif
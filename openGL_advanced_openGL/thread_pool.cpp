@@ -0,0 +1,112 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+ThreadPool::ThreadPool(unsigned int threadCount) {
+	if (threadCount == 0) {
+		threadCount = std::thread::hardware_concurrency();
+		if (threadCount == 0) threadCount = 2;
+	}
+
+	for (unsigned int i = 0; i < threadCount; i++) {
+		workers.emplace_back(&ThreadPool::workerLoop, this);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		stopping = true;
+	}
+	queueCondition.notify_all();
+
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+}
+
+ThreadPool& ThreadPool::shared() {
+	static ThreadPool pool;
+	return pool;
+}
+
+void ThreadPool::enqueue(std::function<void()> task) {
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		tasks.push(std::move(task));
+	}
+	queueCondition.notify_one();
+}
+
+void ThreadPool::workerLoop() {
+	while (true) {
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(queueMutex);
+			queueCondition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+			if (stopping && tasks.empty()) return;
+
+			task = std::move(tasks.front());
+			tasks.pop();
+		}
+		task();
+	}
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& body) {
+	if (count == 0) return;
+
+	// shared with the helper tasks, a helper that only starts after the range is finished
+	// exits without touching body, so the caller never waits on tasks queued behind other work
+	struct Range {
+		std::atomic<size_t> next{ 0 };
+		std::atomic<size_t> finished{ 0 };
+		size_t count = 0;
+		const std::function<void(size_t)>* body = nullptr;
+		std::mutex mutex;
+		std::condition_variable allDone;
+		std::atomic<bool> failed{ false };
+		std::exception_ptr error;		// first exception thrown by body, guarded by mutex
+	};
+	auto range = std::make_shared<Range>();
+	range->count = count;
+	range->body = &body;
+
+	// indices are handed out one at a time so uneven items (big and small meshes) still balance.
+	// A throwing body must not escape into a worker, the index still counts as finished so the
+	// caller's wait ends, and once one has thrown the rest are skipped
+	auto run = [range]() {
+		for (size_t i = range->next++; i < range->count; i = range->next++) {
+			if (!range->failed) {
+				try {
+					(*range->body)(i);
+				}
+				catch (...) {
+					std::lock_guard<std::mutex> lock(range->mutex);
+					if (!range->error) range->error = std::current_exception();
+					range->failed = true;
+				}
+			}
+			if (++range->finished == range->count) {
+				std::lock_guard<std::mutex> lock(range->mutex);
+				range->allDone.notify_all();
+			}
+		}
+	};
+
+	size_t helpers = std::min<size_t>(workers.size(), count - 1);
+	for (size_t i = 0; i < helpers; i++) {
+		enqueue(run);
+	}
+
+	// the calling thread works on the range as well, so it always makes progress
+	run();
+
+	std::unique_lock<std::mutex> lock(range->mutex);
+	range->allDone.wait(lock, [&range]() { return range->finished == range->count; });
+
+	// every index is finished, no helper touches body anymore
+	if (range->error) std::rethrow_exception(range->error);
+}
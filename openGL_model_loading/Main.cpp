@@ -9,8 +9,10 @@
 #include "camera_class.h"
 #include "stb_image.h"
 #include "model.h"
+#include "uniform_buffer.h"
 
 #include <vector>
+#include <string>
 #include <iostream>
 
 // DEFAULT GLOBAL VIEWPORT SETTINGS
@@ -28,6 +30,9 @@ float lastY = SCR_HEIGHT / 2.0f;
 // 
 bool firstMouse = true;
 
+// set by a left click, handled once per frame
+bool pickRequested = false;
+
 // Setting up delta time for camera speed syncing
 float deltaTime = 0.0f;
 float lastFrame = 0.0f;
@@ -55,6 +60,10 @@ void mouse_callback(GLFWwindow* window, double xPosIn, double yPosIn) {
 	camPerspective.processMouseInput(xOffset, yOffset, true);
 }
 
+void mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
+	if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) pickRequested = true;
+}
+
 void scroll_callback(GLFWwindow* window, double xOffset, double yOffset) {
 	// This yOffset is that of the scrollwheel
 	// not to be confused with the camera's yOffset
@@ -140,6 +149,9 @@ int main() {
 	// call back mouse input everytime the cursor is moved
 	glfwSetCursorPosCallback(window, mouse_callback);
 
+	// call back mouse clicks for picking
+	glfwSetMouseButtonCallback(window, mouse_button_callback);
+
 	// call back scroll input everytime the scrollwheel is used
 	glfwSetScrollCallback(window, scroll_callback);
 
@@ -158,46 +170,124 @@ int main() {
 	//stbi_set_flip_vertically_on_load(true);
 
 
-	// INITIALIZE SHADERS AND RELEVANT OBJECTS
-	//std::string object_path = "backpack/backpack.obj";
-	//std::string object_path = "D:/3D projects/Bows and Arrows/Bow models.obj";
-	std::string object_path = "G:/Visual Studio Project/microphone object/untitled.obj";
-	Model ourModel(object_path);
-	Shader ourShader("model_vShader.vert", "model_fShader.frag");
-
-	// RENDER LOOP
-	// -------------------------------------------------------------------------------------------------
-	while (!glfwWindowShouldClose(window)) {
-		processInput(window);
-
-		// rendering commands
-		glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-		float currentFrame = static_cast<float>(glfwGetTime());
-		deltaTime = currentFrame - lastFrame;
-		lastFrame = currentFrame;
-
-
-		// Activate the shader
-		ourShader.use();
-
-
-		glm::mat4 projectMat = glm::perspective(glm::radians(camPerspective.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
-		glm::mat4 viewMat = camPerspective.GetViewMatrix();
-
-		ourShader.setMat4("projection", projectMat);
-		ourShader.setMat4("view", viewMat);
-
-		glm::mat4 model(1.0f);
-		model = glm::translate(model, glm::vec3(0.0f, 0.0f, 0.0f)); // translate it down so it's at the center of the scene
-		model = glm::scale(model, glm::vec3(20.0f, 20.0f, 20.0f));	// it's a bit too big for our scene, so scale it down
-		ourShader.setMat4("model", model);
-		ourModel.Draw(ourShader);
-
-		// Check and call events, swap buffers*
-		glfwSwapBuffers(window);
-		glfwPollEvents();
+	// the model, shader and uniform ring own GL objects, they are released at the end of this block
+	// while the context is still current
+	{
+		// INITIALIZE SHADERS AND RELEVANT OBJECTS
+		//std::string object_path = "backpack/backpack.obj";
+		//std::string object_path = "D:/3D projects/Bows and Arrows/Bow models.obj";
+		std::string object_path = "G:/Visual Studio Project/microphone object/untitled.obj";
+		ModelSettings modelSettings;
+		modelSettings.vertexFormat = VERTEX_FORMAT_COMPACT;
+		modelSettings.packMeshes = true;
+		modelSettings.optimizeMeshes = true;
+		modelSettings.lodRatios = { 0.5f, 0.25f, 0.125f };
+		modelSettings.releaseCpuGeometry = true;	// nothing reads the vertices back once they are on the GPU
+		modelSettings.compressTextures = true;	// BC1/BC3/BC5 instead of RGBA8, a quarter to an eighth of the memory
+		modelSettings.packMaterials = true;	// same sized materials become layers of texture arrays, a few binds per frame instead of one per mesh
+		TextureResidency::shared().setBudget(256u << 20);	// textures idle for a while lose their top mips past this, the material arrays count toward it
+		Model ourModel = Model::LoadAsync(object_path, modelSettings); // meshes stream in while the loop is already running
+		Shader ourShader("model_vShader.vert", "model_fShader.frag");
+		bindUniformBlocks(ourShader);
+
+		// camera block of every frame, written into the region the GPU is done with
+		UniformRing uniformRing;
+
+		CullStats shownStats;
+		TextureResidencyStats shownResidency;
+
+		// meshes of the scene for picking, built once the model finished streaming in
+		Bvh sceneBvh;
+		std::vector<glm::vec3> pickBoundsMin, pickBoundsMax;	// the boxes sceneBvh was last given, per mesh
+		std::vector<glm::vec3> movedBoundsMin, movedBoundsMax;	// this frame's boxes, swapped with the ones above so neither is reallocated
+
+		// RENDER LOOP
+		// -------------------------------------------------------------------------------------------------
+		while (!glfwWindowShouldClose(window)) {
+			processInput(window);
+
+			// rendering commands
+			glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+			float currentFrame = static_cast<float>(glfwGetTime());
+			deltaTime = currentFrame - lastFrame;
+			lastFrame = currentFrame;
+
+			// upload whatever the background loader finished since last frame
+			ourModel.pollAsyncLoad();
+			ourModel.animator.update(deltaTime);
+			size_t movedNodes = ourModel.updateTransforms();
+
+			// Activate the shader
+			ourShader.use();
+
+
+			glm::mat4 projectMat = glm::perspective(glm::radians(camPerspective.Zoom), (float)SCR_WIDTH / (float)SCR_HEIGHT, 0.1f, 100.0f);
+			glm::mat4 viewMat = camPerspective.GetViewMatrix();
+
+			CameraBlock camera;
+			camera.view = viewMat;
+			camera.projection = projectMat;
+			camera.position = glm::vec4(camPerspective.Position, 1.0f);
+			uniformRing.beginFrame();
+			size_t cameraOffset = uniformRing.push(camera);
+			uniformRing.upload();
+			uniformRing.bind<CameraBlock>(CAMERA_BLOCK_BINDING, cameraOffset);
+
+			glm::mat4 model(1.0f);
+			model = glm::translate(model, glm::vec3(0.0f, 0.0f, 0.0f)); // translate it down so it's at the center of the scene
+			model = glm::scale(model, glm::vec3(20.0f, 20.0f, 20.0f));	// it's a bit too big for our scene, so scale it down
+			ourModel.Draw(ourShader, camPerspective, projectMat, model, (float)SCR_HEIGHT);
+			uniformRing.endFrame();
+
+			if (sceneBvh.empty() && !ourModel.isLoading() && !ourModel.meshes_list.empty()) {
+				ourModel.meshWorldBounds(model, pickBoundsMin, pickBoundsMax);
+				sceneBvh.build(pickBoundsMin.data(), pickBoundsMax.data(), pickBoundsMin.size());
+			}
+			else if (movedNodes > 0 && !sceneBvh.empty()) {
+				// animated nodes carried their meshes along, only the paths above the boxes that changed are refit
+				movedBoundsMin.clear();
+				movedBoundsMax.clear();
+				ourModel.meshWorldBounds(model, movedBoundsMin, movedBoundsMax);
+				for (uint32_t i = 0; i < movedBoundsMin.size(); i++) {
+					if (movedBoundsMin[i] == pickBoundsMin[i] && movedBoundsMax[i] == pickBoundsMax[i]) continue;
+					sceneBvh.update(i, movedBoundsMin[i], movedBoundsMax[i]);
+				}
+				sceneBvh.refit();
+				pickBoundsMin.swap(movedBoundsMin);
+				pickBoundsMax.swap(movedBoundsMax);
+			}
+
+			// the cursor is captured for mouse look, pick through the middle of the screen
+			if (pickRequested) {
+				pickRequested = false;
+				BvhHit hit;
+				glm::vec3 direction = camPerspective.GetRayDirection(SCR_WIDTH * 0.5f, SCR_HEIGHT * 0.5f, (float)SCR_WIDTH, (float)SCR_HEIGHT);
+				if (sceneBvh.raycast(camPerspective.Position, direction, hit)) std::cout << "PICKED:: mesh " << hit.object << " at distance " << hit.distance << std::endl;
+				else std::cout << "PICKED:: nothing" << std::endl;
+			}
+
+			// drop or restore texture levels against the budget, by what was drawn this frame
+			TextureResidency::shared().endFrame();
+			const TextureResidencyStats& residency = TextureResidency::shared().stats();
+			if (residency.evictedLevels > 0 || residency.restoredLevels > 0) TextureResidency::shared().printStats();
+
+			// frustum culling and texture memory of this frame, the title is only touched when they change
+			const CullStats& cullStats = ourModel.cullStats();
+			if (cullStats.drawn != shownStats.drawn || cullStats.culled != shownStats.culled
+				|| residency.residentBytes != shownResidency.residentBytes || residency.totalEvictedLevels != shownResidency.totalEvictedLevels) {
+				std::string title = "learnOpenGL_model_loading - drawn " + std::to_string(cullStats.drawn) + ", culled " + std::to_string(cullStats.culled)
+					+ ", textures " + std::to_string(residency.residentBytes >> 20) + " MB, evicted " + std::to_string(residency.totalEvictedLevels) + " mips";
+				glfwSetWindowTitle(window, title.c_str());
+				shownStats = cullStats;
+				shownResidency = residency;
+			}
+
+			// Check and call events, swap buffers*
+			glfwSwapBuffers(window);
+			glfwPollEvents();
+		}
 	}
 
 
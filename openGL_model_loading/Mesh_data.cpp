@@ -1,57 +1,209 @@
 #include "mesh_data.h"
 
+#include <glm/glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+Mesh::~Mesh() {
+	if (!VBO) return;
+	glDeleteVertexArrays(1, &VAO);
+	glDeleteBuffers(1, &VBO);
+	glDeleteBuffers(1, &EBO);
+	if (skinVBO) glDeleteBuffers(1, &skinVBO);
+}
+
+Mesh::Mesh(Mesh&& other) noexcept {
+	swap(other);
+}
+
+// the old buffers go away with the temporary
+Mesh& Mesh::operator=(Mesh&& other) noexcept {
+	Mesh moved(std::move(other));
+	swap(moved);
+	return *this;
+}
+
+void Mesh::swap(Mesh& other) noexcept {
+	std::swap(vertices, other.vertices);
+	std::swap(indices, other.indices);
+	std::swap(shortIndices, other.shortIndices);
+	std::swap(textures, other.textures);
+	std::swap(VAO, other.VAO);
+	std::swap(indexCount, other.indexCount);
+	std::swap(firstIndex, other.firstIndex);
+	std::swap(baseVertex, other.baseVertex);
+	std::swap(lods, other.lods);
+	std::swap(currentLod, other.currentLod);
+	std::swap(boundsMin, other.boundsMin);
+	std::swap(boundsMax, other.boundsMax);
+	std::swap(sphereCenter, other.sphereCenter);
+	std::swap(sphereRadius, other.sphereRadius);
+	std::swap(format, other.format);
+	std::swap(positionOffset, other.positionOffset);
+	std::swap(positionScale, other.positionScale);
+	std::swap(vertexBytes, other.vertexBytes);
+	std::swap(indexType, other.indexType);
+	std::swap(indexBytes, other.indexBytes);
+	std::swap(skinned, other.skinned);
+	std::swap(cpuSkinned, other.cpuSkinned);
+	std::swap(instanceBuffer, other.instanceBuffer);
+	std::swap(node, other.node);
+	std::swap(materialGroup, other.materialGroup);
+	std::swap(materialLayer, other.materialLayer);
+	std::swap(material, other.material);
+	std::swap(VBO, other.VBO);
+	std::swap(EBO, other.EBO);
+	std::swap(skinVBO, other.skinVBO);
+}
+
+void Mesh::keepGeometry(std::vector<Vertex>&& vertexData, std::vector<unsigned int>&& indexData) {
+	vertices = std::move(vertexData);
+	if (indexType == GL_UNSIGNED_SHORT) {
+		shortIndices.assign(indexData.begin(), indexData.end());
+		indexData = std::vector<unsigned int>();
+		indices.clear();
+	}
+	else {
+		indices = std::move(indexData);
+		shortIndices.clear();
+	}
+}
+
+void Mesh::releaseGeometry() {
+	// swapping with empty vectors gives the memory back, clear() would keep the capacity
+	std::vector<Vertex>().swap(vertices);
+	std::vector<unsigned int>().swap(indices);
+	std::vector<uint16_t>().swap(shortIndices);
+}
+
 // setup the materials and draw the meshes
 void Mesh::Draw(Shader &shader) {
-	unsigned int diffuseNr = 1;
-	unsigned int specularNr = 1;
-	unsigned int normalNr = 1;
-	unsigned int heightNr = 1;
-
-
-	for (unsigned int i = 0; i < textures.size(); i++){
-		glActiveTexture(GL_TEXTURE0 + i);
-
-		std::string number;
-		std::string name = textures[i].type;
-
-		if (name == "texture_diffuse")
-			number = std::to_string(diffuseNr++);
-		else if (name == "texture_specular")
-			number = std::to_string(specularNr++);
-		else if (name == "texture_normal")
-			number = std::to_string(normalNr++);
-		else if (name == "texture_height")
-			number = std::to_string(heightNr++);
-
-		glUniform1i(glGetUniformLocation(shader.ID, (name + number).c_str()), i);
-		/*shader.setInt(("material." + name + number).c_str(), i);*/
-		glBindTexture(GL_TEXTURE_2D, textures[i].id);
+	bindMaterial(shader, false);
+
+	// draw mesh
+	glBindVertexArray(VAO);
+	glDrawElementsBaseVertex(GL_TRIANGLES, drawIndexCount(), indexType, (void*)(drawFirstIndex() * indexSize()), baseVertex);
+	glBindVertexArray(0);
+}
+
+void Mesh::DrawInstanced(Shader& shader, const InstanceBuffer& instances) {
+	if (instances.count() == 0) return;
+
+	// attributes are VAO state, they only have to be set up once per buffer
+	if (instanceBuffer != instances.id()) {
+		instances.attach(VAO);
+		instanceBuffer = instances.id();
 	}
 
+	bindMaterial(shader, true);
 
-	// draw mesh
 	glBindVertexArray(VAO);
-	glDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, 0);
+	glDrawElementsInstancedBaseVertex(GL_TRIANGLES, drawIndexCount(), indexType, (void*)(drawFirstIndex() * indexSize()),
+		static_cast<GLsizei>(instances.count()), baseVertex);
 	glBindVertexArray(0);
+}
 
-	glActiveTexture(GL_TEXTURE0); // restore default active texture
+void Mesh::DrawInstanced(Shader& shader, InstanceBuffer& instances, const glm::mat4* transforms, size_t count) {
+	instances.upload(transforms, count);
+	DrawInstanced(shader, instances);
+}
+
+void Mesh::bindMaterial(Shader& shader, bool instanced) {
+	material.apply(shader, *this, instanced);
+}
+
+void Mesh::setGeometry(const Vertex* vertexData, size_t numVertices, size_t numIndices, const std::vector<MeshLod>& levels) {
+	vertexBounds(vertexData, numVertices, boundsMin, boundsMax);
+	vertexBoundingSphere(vertexData, numVertices, boundsMin, boundsMax, sphereCenter, sphereRadius);
+
+	lods = levels;
+	if (lods.empty()) {
+		MeshLod full;
+		full.firstIndex = 0;
+		full.indexCount = static_cast<unsigned int>(numIndices);
+		full.error = 0.0f;
+		lods.push_back(full);
+	}
+	currentLod = 0;
+	indexCount = lods[0].indexCount;
 }
 
 // Setup meshes' data into arrays buffers to be processed
-void Mesh::setupMesh() {
+void Mesh::setupMesh(const Vertex* vertexData, size_t numVertices, const unsigned int* indexData, size_t numIndices, VertexFormat vertexFormat) {
+	format = vertexFormat;
+
 	glGenVertexArrays(1, &VAO);
 	glGenBuffers(1, &VBO);
 	glGenBuffers(1, &EBO);
 
 	glBindVertexArray(VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	
-	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
 
 	// the code was crashing violation here due to missing ebo
 
 	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+	// half the index memory and fetch bandwidth whenever the vertices can be addressed with 16 bits
+	indexType = numVertices <= MAX_SHORT_INDEX_VERTICES ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	indexBytes = numIndices * indexSize();
+	if (indexType == GL_UNSIGNED_SHORT) {
+		std::vector<uint16_t> shortData(indexData, indexData + numIndices);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, shortData.data(), GL_STATIC_DRAW);
+	}
+	else glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, indexData, GL_STATIC_DRAW);
+
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	if (format == VERTEX_FORMAT_COMPACT) {
+		quantizationBox(boundsMin, boundsMax, positionOffset, positionScale);
+
+		std::vector<CompactVertex> compact(numVertices);
+		skinned = encodeCompactVertices(vertexData, numVertices, positionOffset, positionScale, compact.data());
+
+		glBufferData(GL_ARRAY_BUFFER, compact.size() * sizeof(CompactVertex), compact.data(), GL_STATIC_DRAW);
+		vertexBytes = compact.size() * sizeof(CompactVertex);
+		setupVertexAttributes(format);
+
+		if (skinned) setupCompactSkin(vertexData, numVertices);
+	}
+	else {
+		glBufferData(GL_ARRAY_BUFFER, numVertices * sizeof(Vertex), vertexData, GL_STATIC_DRAW);
+		vertexBytes = numVertices * sizeof(Vertex);
+		setupVertexAttributes(format);
+		skinned = hasBoneWeights(vertexData, numVertices);
+	}
+
+	glBindVertexArray(0); // if we always bind VAO anyway, this is not necessary
+
+}
+
+// new storage every time, the driver hands the old one back once the frames still drawing from it are done
+// instead of making this one wait for them
+void Mesh::updateVertices(const Vertex* vertexData, size_t numVertices) {
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, numVertices * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, numVertices * sizeof(Vertex), vertexData);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void setupVertexAttributes(VertexFormat format) {
+	if (format == VERTEX_FORMAT_COMPACT) {
+		// positions, w = bitangent sign
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, 4, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, Position));
+
+		// octahedral normals
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, Normal));
+
+		// half float coords
+		glEnableVertexAttribArray(2);
+		glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, TexCoords));
+
+		// octahedral tangent, the bitangent (4) is derived in the shader
+		glEnableVertexAttribArray(3);
+		glVertexAttribPointer(3, 2, GL_SHORT, GL_TRUE, sizeof(CompactVertex), (void*)offsetof(CompactVertex, Tangent));
+		return;
+	}
 
 	// vertex positions
 	glEnableVertexAttribArray(0);
@@ -78,7 +230,110 @@ void Mesh::setupMesh() {
 	// weights
 	glEnableVertexAttribArray(6);
 	glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, m_Weights));
-	glBindVertexArray(0); // if we always bind VAO anyway, this is not necessary
+}
+
+void vertexBounds(const Vertex* vertices, size_t numVertices, glm::vec3& boundsMin, glm::vec3& boundsMax) {
+	boundsMin = boundsMax = glm::vec3(0.0f);
+	if (numVertices > 0) boundsMin = boundsMax = vertices[0].Position;
+	for (size_t i = 1; i < numVertices; i++) {
+		boundsMin = glm::min(boundsMin, vertices[i].Position);
+		boundsMax = glm::max(boundsMax, vertices[i].Position);
+	}
+}
+
+void vertexBoundingSphere(const Vertex* vertices, size_t numVertices, const glm::vec3& boundsMin, const glm::vec3& boundsMax, glm::vec3& center, float& radius) {
+	center = (boundsMin + boundsMax) * 0.5f;
+	float farthest = 0.0f;
+	for (size_t i = 0; i < numVertices; i++) {
+		glm::vec3 offset = vertices[i].Position - center;
+		farthest = std::max(farthest, glm::dot(offset, offset));
+	}
+	radius = std::sqrt(farthest);
+}
+
+void quantizationBox(const glm::vec3& boundsMin, const glm::vec3& boundsMax, glm::vec3& offset, glm::vec3& scale) {
+	offset = boundsMin;
+	scale = boundsMax - boundsMin;
+	// flat axes would divide by zero, any scale decodes them back to the offset
+	for (int axis = 0; axis < 3; axis++) {
+		if (scale[axis] <= 0.0f) scale[axis] = 1.0f;
+	}
+}
 
+bool hasBoneWeights(const Vertex* vertices, size_t numVertices) {
+	for (size_t i = 0; i < numVertices; i++) {
+		for (int j = 0; j < MAX_BONE_INFLUENCE; j++) {
+			if (vertices[i].m_Weights[j] > 0.0f) return true;
+		}
+	}
+	return false;
+}
+
+// map a unit vector onto the octahedron and unfold it into [-1, 1]^2
+static void octEncode(glm::vec3 n, int16_t out[2]) {
+	float sum = std::fabs(n.x) + std::fabs(n.y) + std::fabs(n.z);
+	float x = 0.0f, y = 0.0f;
+	if (sum > 0.0f) {
+		x = n.x / sum;
+		y = n.y / sum;
+		if (n.z < 0.0f) {
+			float foldX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+			float foldY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+			x = foldX;
+			y = foldY;
+		}
+	}
+	out[0] = static_cast<int16_t>(glm::packSnorm1x16(x));
+	out[1] = static_cast<int16_t>(glm::packSnorm1x16(y));
 }
 
+bool encodeCompactVertices(const Vertex* vertices, size_t numVertices, const glm::vec3& offset, const glm::vec3& scale, CompactVertex* out) {
+	bool skinned = false;
+	for (size_t i = 0; i < numVertices; i++) {
+		const Vertex& vertex = vertices[i];
+		CompactVertex& compact = out[i];
+
+		glm::vec3 unit = (vertex.Position - offset) / scale;
+		for (int axis = 0; axis < 3; axis++) compact.Position[axis] = glm::packUnorm1x16(unit[axis]);
+
+		// handedness of the tangent frame, the bitangent is rebuilt as cross(N, T) * sign
+		bool flipped = glm::dot(glm::cross(vertex.Normal, vertex.Tangent), vertex.Bitangent) < 0.0f;
+		compact.Position[3] = flipped ? 0 : 65535;
+
+		octEncode(vertex.Normal, compact.Normal);
+		octEncode(vertex.Tangent, compact.Tangent);
+
+		compact.TexCoords[0] = glm::packHalf1x16(vertex.TexCoords.x);
+		compact.TexCoords[1] = glm::packHalf1x16(vertex.TexCoords.y);
+
+		for (int j = 0; j < MAX_BONE_INFLUENCE; j++) {
+			if (vertex.m_Weights[j] > 0.0f) skinned = true;
+		}
+	}
+	return skinned;
+}
+
+// bone data of a skinned compact mesh, in its own buffer next to the CompactVertex one
+void Mesh::setupCompactSkin(const Vertex* vertexData, size_t numVertices) {
+	std::vector<CompactSkin> skin(numVertices);
+	for (size_t i = 0; i < numVertices; i++) {
+		for (int j = 0; j < MAX_BONE_INFLUENCE; j++) {
+			bool used = vertexData[i].m_Weights[j] > 0.0f && vertexData[i].m_BoneIDs[j] >= 0;
+			skin[i].BoneIDs[j] = used ? static_cast<uint16_t>(vertexData[i].m_BoneIDs[j]) : 0;
+			skin[i].Weights[j] = used ? glm::packUnorm1x8(vertexData[i].m_Weights[j]) : 0;
+		}
+	}
+
+	glGenBuffers(1, &skinVBO);
+	glBindBuffer(GL_ARRAY_BUFFER, skinVBO);
+	glBufferData(GL_ARRAY_BUFFER, skin.size() * sizeof(CompactSkin), skin.data(), GL_STATIC_DRAW);
+	vertexBytes += skin.size() * sizeof(CompactSkin);
+
+	// ids
+	glEnableVertexAttribArray(5);
+	glVertexAttribIPointer(5, 4, GL_UNSIGNED_SHORT, sizeof(CompactSkin), (void*)offsetof(CompactSkin, BoneIDs));
+
+	// weights
+	glEnableVertexAttribArray(6);
+	glVertexAttribPointer(6, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(CompactSkin), (void*)offsetof(CompactSkin, Weights));
+}
@@ -0,0 +1,227 @@
+#include "animation_cache.h"
+#include "mesh_cache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace fs = std::filesystem;
+
+static const char ANIMATION_CACHE_MAGIC[4] = { 'A', 'N', 'M', 'C' };
+
+// append plain data to the file image
+class BlobWriter {
+public:
+	std::vector<unsigned char> bytes;
+
+	void put(const void* data, size_t size) {
+		const unsigned char* begin = static_cast<const unsigned char*>(data);
+		bytes.insert(bytes.end(), begin, begin + size);
+	}
+	template <typename T> void put(const T& value) { put(&value, sizeof(T)); }
+	template <typename T> void putArray(const std::vector<T>& values) {
+		put(static_cast<uint32_t>(values.size()));
+		if (!values.empty()) put(values.data(), values.size() * sizeof(T));
+	}
+	void putString(const std::string& text) {
+		put(static_cast<uint32_t>(text.size()));
+		put(text.data(), text.size());
+	}
+};
+
+// bounds checked reads, every get fails once the data ran out
+class BlobReader {
+public:
+	BlobReader(const unsigned char* data, size_t size) : cursor(data), end(data + size) {}
+
+	bool get(void* out, size_t size) {
+		if (size > static_cast<size_t>(end - cursor)) return false;
+		std::memcpy(out, cursor, size);
+		cursor += size;
+		return true;
+	}
+	template <typename T> bool get(T& value) { return get(&value, sizeof(T)); }
+	template <typename T> bool getArray(std::vector<T>& values) {
+		uint32_t count;
+		if (!get(count) || count > static_cast<size_t>(end - cursor) / sizeof(T)) return false;
+		values.resize(count);
+		return count == 0 || get(values.data(), count * sizeof(T));
+	}
+	bool getString(std::string& text) {
+		uint32_t length;
+		if (!get(length) || length > static_cast<size_t>(end - cursor)) return false;
+		text.assign(reinterpret_cast<const char*>(cursor), length);
+		cursor += length;
+		return true;
+	}
+	bool atEnd() const { return cursor == end; }
+
+private:
+	const unsigned char* cursor;
+	const unsigned char* end;
+};
+
+std::vector<unsigned char> AnimationCache::serialize(const Skeleton& skeleton) {
+	BlobWriter blob;
+	blob.put(static_cast<uint32_t>(skeleton.nodes.size()));
+	for (const SkeletonNode& node : skeleton.nodes) {
+		blob.putString(node.name);
+		blob.put(static_cast<int32_t>(node.parent));
+		blob.put(static_cast<int32_t>(node.bone));
+		blob.put(node.bindLocal);
+	}
+
+	// bone names in palette slot order
+	std::vector<std::string> boneNames(skeleton.boneCount());
+	for (const auto& bone : skeleton.boneIndex) boneNames[bone.second] = bone.first;
+	blob.put(static_cast<uint32_t>(skeleton.boneCount()));
+	for (size_t i = 0; i < skeleton.boneCount(); i++) {
+		blob.putString(boneNames[i]);
+		blob.put(skeleton.boneOffsets[i]);
+	}
+	blob.put(skeleton.globalInverse);
+
+	blob.put(static_cast<uint32_t>(skeleton.clips.size()));
+	for (const CompressedClip& clip : skeleton.clips) {
+		blob.putString(clip.name);
+		blob.put(clip.duration);
+		blob.put(clip.frameCount);
+		blob.putArray(clip.tracks);
+		blob.putArray(clip.keyData);
+		blob.putArray(clip.segments);
+	}
+	return blob.bytes;
+}
+
+bool AnimationCache::write(const std::string& sourcePath, unsigned int importFlags, const Skeleton& skeleton) {
+	AnimationCacheHeader header{};
+	std::memcpy(header.magic, ANIMATION_CACHE_MAGIC, 4);
+	header.version = ANIMATION_CACHE_VERSION;
+	header.importFlags = importFlags;
+	header.trackSize = sizeof(ClipTrack);
+	if (!cacheSourceStat(sourcePath, header.sourceMtime, header.sourceSize)) return false;
+
+	std::string key = cacheSourceKey(sourcePath);
+
+	BlobWriter blob;
+	blob.put(&header, sizeof(header)); // filled in once the payload is hashed
+	blob.putString(key);
+	std::vector<unsigned char> payload = serialize(skeleton);
+	blob.put(payload.data(), payload.size());
+
+	header.fileSize = blob.bytes.size();
+	header.payloadHash = cacheHash(blob.bytes.data() + sizeof(header), blob.bytes.size() - sizeof(header));
+	std::memcpy(blob.bytes.data(), &header, sizeof(header));
+
+	std::error_code ec;
+	fs::create_directories(MESH_CACHE_DIR, ec);
+
+	std::string cachePath = cacheEntryPath(key, ".acache");
+	std::string tempPath = cachePath + ".tmp";
+	{
+		std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+		out.write(reinterpret_cast<const char*>(blob.bytes.data()), blob.bytes.size());
+		if (!out) {
+			std::cout << "ERROR::ANIMATION_CACHE::WRITE_FAILED: " << tempPath << std::endl;
+			return false;
+		}
+	}
+
+	fs::rename(tempPath, cachePath, ec);
+	if (ec) {
+		std::cout << "ERROR::ANIMATION_CACHE::WRITE_FAILED: " << ec.message() << std::endl;
+		fs::remove(tempPath, ec);
+		return false;
+	}
+	return true;
+}
+
+// every index a sampler or Animator follows has to stay in range
+static bool validClip(const CompressedClip& clip, size_t numNodes) {
+	if (clip.frameCount == 0 || clip.frameCount > CLIP_MAX_FRAMES) return false;
+	uint32_t numSegments = (clip.frameCount - 1) / CLIP_SEGMENT_FRAMES + 1;
+
+	for (const ClipTrack& track : clip.tracks) {
+		if (track.node >= numNodes || track.type > TRACK_SCALE || track.numKeys == 0) return false;
+		uint64_t stride = track.type == TRACK_ROTATION ? 5 : 4;
+		if (uint64_t(track.keyOffset) + track.numKeys * stride > clip.keyData.size()) return false;
+		if (uint64_t(track.segmentOffset) + numSegments > clip.segments.size()) return false;
+		for (uint32_t s = 0; s < numSegments; s++) {
+			if (clip.segments[track.segmentOffset + s] >= track.numKeys) return false;
+		}
+	}
+	return true;
+}
+
+bool AnimationCache::read(const std::string& sourcePath, unsigned int importFlags, Skeleton& skeleton) {
+	int64_t mtime;
+	uint64_t size;
+	if (!cacheSourceStat(sourcePath, mtime, size)) return false;
+
+	std::string key = cacheSourceKey(sourcePath);
+	std::ifstream in(cacheEntryPath(key, ".acache"), std::ios::binary);
+	if (!in) return false;
+	std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+	AnimationCacheHeader header;
+	if (bytes.size() < sizeof(header)) return false;
+	std::memcpy(&header, bytes.data(), sizeof(header));
+
+	if (std::memcmp(header.magic, ANIMATION_CACHE_MAGIC, 4) != 0 || header.version != ANIMATION_CACHE_VERSION) return false;
+	if (header.importFlags != importFlags || header.trackSize != sizeof(ClipTrack)) return false;
+	if (header.sourceMtime != mtime || header.sourceSize != size || header.fileSize != bytes.size()) return false;
+	if (cacheHash(bytes.data() + sizeof(header), bytes.size() - sizeof(header)) != header.payloadHash) return false;
+
+	BlobReader keyBlob(bytes.data() + sizeof(header), bytes.size() - sizeof(header));
+	std::string storedKey;
+	if (!keyBlob.getString(storedKey) || storedKey != key) return false;
+
+	size_t payloadOffset = sizeof(header) + sizeof(uint32_t) + storedKey.size();
+	return deserialize(bytes.data() + payloadOffset, bytes.size() - payloadOffset, skeleton);
+}
+
+bool AnimationCache::deserialize(const unsigned char* data, size_t size, Skeleton& skeleton) {
+	Skeleton loaded;
+	BlobReader blob(data, size);
+
+	uint32_t numNodes, numBones, numClips;
+	if (!blob.get(numNodes)) return false;
+	for (uint32_t i = 0; i < numNodes; i++) {
+		SkeletonNode node;
+		int32_t parent, bone;
+		if (!blob.getString(node.name) || !blob.get(parent) || !blob.get(bone) || !blob.get(node.bindLocal)) return false;
+		if (parent >= static_cast<int32_t>(i) || parent < -1) return false; // parents come first
+		node.parent = parent;
+		node.bone = bone;
+		loaded.nodes.push_back(node);
+	}
+
+	if (!blob.get(numBones)) return false;
+	for (uint32_t i = 0; i < numBones; i++) {
+		std::string name;
+		glm::mat4 offset;
+		if (!blob.getString(name) || !blob.get(offset)) return false;
+		loaded.boneIndex[name] = static_cast<int>(i);
+		loaded.boneOffsets.push_back(offset);
+	}
+	for (const SkeletonNode& node : loaded.nodes) {
+		if (node.bone < -1 || node.bone >= static_cast<int>(numBones)) return false;
+	}
+	if (!blob.get(loaded.globalInverse)) return false;
+
+	if (!blob.get(numClips)) return false;
+	for (uint32_t i = 0; i < numClips; i++) {
+		CompressedClip clip;
+		if (!blob.getString(clip.name) || !blob.get(clip.duration) || !blob.get(clip.frameCount)) return false;
+		if (!blob.getArray(clip.tracks) || !blob.getArray(clip.keyData) || !blob.getArray(clip.segments)) return false;
+		if (!validClip(clip, numNodes)) return false;
+		loaded.clips.push_back(std::move(clip));
+	}
+	if (!blob.atEnd()) return false;
+
+	if (!loaded.empty() || !loaded.clips.empty()) buildBindPose(loaded);
+	skeleton = std::move(loaded);
+	return true;
+}
@@ -0,0 +1,38 @@
+#ifndef ANIMATION_CACHE_H
+#define ANIMATION_CACHE_H
+
+#include "skeleton.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define ANIMATION_CACHE_VERSION 1
+
+// On-disk layout, next to the mesh cache entry of the same model with an .acache extension:
+// [AnimationCacheHeader][source path][nodes][bones][global inverse][clips]
+struct AnimationCacheHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t importFlags;
+	uint32_t trackSize;			// sizeof(ClipTrack) when written, catches layout changes
+	int64_t sourceMtime;
+	uint64_t sourceSize;
+	uint64_t fileSize;
+	uint64_t payloadHash;		// hash of everything after the header
+};
+
+// Skeleton and compressed clips of a model. Written for every cached model, an empty skeleton
+// included, so a mesh cache hit never has to open the source file again
+class AnimationCache {
+public:
+	// false when the entry is missing, stale or corrupt
+	static bool read(const std::string& sourcePath, unsigned int importFlags, Skeleton& skeleton);
+	static bool write(const std::string& sourcePath, unsigned int importFlags, const Skeleton& skeleton);
+
+	// the payload alone, without header or source path, for files that embed a skeleton
+	static std::vector<unsigned char> serialize(const Skeleton& skeleton);
+	static bool deserialize(const unsigned char* data, size_t size, Skeleton& skeleton);
+};
+
+#endif
@@ -0,0 +1,489 @@
+#include "animation_clip.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CLIP_SSE
+#endif
+
+// keys are never further apart than this, keeps the key reduction linear in the clip length
+#define CLIP_MAX_KEY_GAP 256
+
+size_t CompressedClip::memory() const {
+	return sizeof(CompressedClip) + name.size() + tracks.size() * sizeof(ClipTrack)
+		+ keyData.size() * sizeof(uint16_t) + segments.size() * sizeof(uint16_t);
+}
+
+size_t rawClipMemory(const AnimationClip& clip) {
+	size_t bytes = 0;
+	for (const AnimationChannel& channel : clip.channels) {
+		bytes += (channel.positions.size() + channel.scales.size()) * sizeof(VectorKey) + channel.rotations.size() * sizeof(RotationKey);
+	}
+	return bytes;
+}
+
+void LocalPose::resize(size_t nodes) {
+	count = (nodes + 3) & ~size_t(3);
+	tx.assign(count, 0.0f);
+	ty.assign(count, 0.0f);
+	tz.assign(count, 0.0f);
+	rx.assign(count, 0.0f);
+	ry.assign(count, 0.0f);
+	rz.assign(count, 0.0f);
+	rw.assign(count, 1.0f);
+	sx.assign(count, 1.0f);
+	sy.assign(count, 1.0f);
+	sz.assign(count, 1.0f);
+}
+
+void LocalPose::copyFrom(const LocalPose& other) {
+	std::copy(other.tx.begin(), other.tx.end(), tx.begin());
+	std::copy(other.ty.begin(), other.ty.end(), ty.begin());
+	std::copy(other.tz.begin(), other.tz.end(), tz.begin());
+	std::copy(other.rx.begin(), other.rx.end(), rx.begin());
+	std::copy(other.ry.begin(), other.ry.end(), ry.begin());
+	std::copy(other.rz.begin(), other.rz.end(), rz.begin());
+	std::copy(other.rw.begin(), other.rw.end(), rw.begin());
+	std::copy(other.sx.begin(), other.sx.end(), sx.begin());
+	std::copy(other.sy.begin(), other.sy.end(), sy.begin());
+	std::copy(other.sz.begin(), other.sz.end(), sz.begin());
+}
+
+void LocalPose::set(size_t node, const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale) {
+	tx[node] = translation.x;
+	ty[node] = translation.y;
+	tz[node] = translation.z;
+	rx[node] = rotation.x;
+	ry[node] = rotation.y;
+	rz[node] = rotation.z;
+	rw[node] = rotation.w;
+	sx[node] = scale.x;
+	sy[node] = scale.y;
+	sz[node] = scale.z;
+}
+
+void decomposeTransform(const glm::mat4& transform, glm::vec3& translation, glm::quat& rotation, glm::vec3& scale) {
+	translation = glm::vec3(transform[3]);
+
+	glm::vec3 columns[3] = { glm::vec3(transform[0]), glm::vec3(transform[1]), glm::vec3(transform[2]) };
+	scale = glm::vec3(glm::length(columns[0]), glm::length(columns[1]), glm::length(columns[2]));
+	// a mirrored basis keeps the flip in the scale, the rotation has to stay proper
+	if (glm::dot(glm::cross(columns[0], columns[1]), columns[2]) < 0.0f) scale.x = -scale.x;
+	for (int i = 0; i < 3; i++) {
+		if (scale[i] != 0.0f) columns[i] /= scale[i];
+	}
+
+	// rotation matrix to quaternion, starting from the largest term for precision. rij is row i, column j
+	float r00 = columns[0].x, r11 = columns[1].y, r22 = columns[2].z;
+	float r01 = columns[1].x, r10 = columns[0].y;
+	float r02 = columns[2].x, r20 = columns[0].z;
+	float r12 = columns[2].y, r21 = columns[1].z;
+
+	float trace = r00 + r11 + r22;
+	if (trace > 0.0f) {
+		float s = std::sqrt(trace + 1.0f) * 2.0f;
+		rotation = glm::quat(0.25f * s, (r21 - r12) / s, (r02 - r20) / s, (r10 - r01) / s);
+	}
+	else if (r00 > r11 && r00 > r22) {
+		float s = std::sqrt(1.0f + r00 - r11 - r22) * 2.0f;
+		rotation = glm::quat((r21 - r12) / s, 0.25f * s, (r01 + r10) / s, (r02 + r20) / s);
+	}
+	else if (r11 > r22) {
+		float s = std::sqrt(1.0f + r11 - r00 - r22) * 2.0f;
+		rotation = glm::quat((r02 - r20) / s, (r01 + r10) / s, 0.25f * s, (r12 + r21) / s);
+	}
+	else {
+		float s = std::sqrt(1.0f + r22 - r00 - r11) * 2.0f;
+		rotation = glm::quat((r10 - r01) / s, (r02 + r20) / s, (r12 + r21) / s, 0.25f * s);
+	}
+	rotation = glm::normalize(rotation);
+}
+
+
+// last raw key at or before time, the cursor makes resampling a clip front to back linear
+template <typename Key>
+static unsigned int findKey(const std::vector<Key>& keys, float time, unsigned int& cursor) {
+	if (cursor >= keys.size() || keys[cursor].time > time) cursor = 0;
+	while (cursor + 1 < keys.size() && keys[cursor + 1].time <= time) cursor++;
+	return cursor;
+}
+
+template <typename Key>
+static float keyFactor(const std::vector<Key>& keys, unsigned int key, float time) {
+	float span = keys[key + 1].time - keys[key].time;
+	return span > 0.0f ? glm::clamp((time - keys[key].time) / span, 0.0f, 1.0f) : 0.0f;
+}
+
+static glm::vec4 sampleRaw(const std::vector<VectorKey>& keys, float time, unsigned int& cursor) {
+	unsigned int key = findKey(keys, time, cursor);
+	if (key + 1 >= keys.size()) return glm::vec4(keys[key].value, 0.0f);
+	return glm::vec4(glm::mix(keys[key].value, keys[key + 1].value, keyFactor(keys, key, time)), 0.0f);
+}
+
+static glm::vec4 sampleRaw(const std::vector<RotationKey>& keys, float time, unsigned int& cursor) {
+	unsigned int key = findKey(keys, time, cursor);
+	glm::quat rotation = keys[key].value;
+	if (key + 1 < keys.size()) rotation = glm::normalize(glm::slerp(keys[key].value, keys[key + 1].value, keyFactor(keys, key, time)));
+	return glm::vec4(rotation.x, rotation.y, rotation.z, rotation.w);
+}
+
+static float maxDifference(const glm::vec4& a, const glm::vec4& b, int components) {
+	float difference = 0.0f;
+	for (int c = 0; c < components; c++) difference = std::max(difference, std::fabs(a[c] - b[c]));
+	return difference;
+}
+
+static float dot4(const glm::vec4& a, const glm::vec4& b) {
+	return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+// whether interpolating samples[first] to samples[last] stays within tolerance of every frame in between
+static bool lineFits(const std::vector<glm::vec4>& samples, size_t first, size_t last, int components, float tolerance) {
+	for (size_t frame = first + 1; frame < last; frame++) {
+		float t = float(frame - first) / float(last - first);
+		glm::vec4 value = samples[first] + (samples[last] - samples[first]) * t;
+		if (components == 4) value = value / std::sqrt(dot4(value, value));
+		if (maxDifference(value, samples[frame], components) > tolerance) return false;
+	}
+	return true;
+}
+
+static void addTrack(CompressedClip& clip, uint32_t node, ClipTrackType type, const std::vector<glm::vec4>& samples, const glm::vec4& bind, float tolerance) {
+	int components = type == TRACK_ROTATION ? 4 : 3;
+	size_t numFrames = samples.size();
+
+	// q and -q are the same rotation, compare against the bind pose on the samples' side
+	glm::vec4 reference = bind;
+	if (type == TRACK_ROTATION && dot4(samples[0], bind) < 0.0f) reference = bind * -1.0f;
+
+	bool atBind = true, constant = true;
+	for (size_t frame = 0; frame < numFrames; frame++) {
+		if (maxDifference(samples[frame], reference, components) > tolerance) atBind = false;
+		if (maxDifference(samples[frame], samples[0], components) > tolerance) constant = false;
+	}
+	if (atBind) return; // the sampler falls back to the bind pose anyway
+
+	// greedy key reduction, a key is kept where the line from the previous one stops fitting
+	std::vector<uint32_t> kept(1, 0);
+	if (!constant) {
+		size_t anchor = 0;
+		for (size_t end = 2; end < numFrames; end++) {
+			if (end - anchor > CLIP_MAX_KEY_GAP || !lineFits(samples, anchor, end, components, tolerance)) {
+				anchor = end - 1;
+				kept.push_back(static_cast<uint32_t>(anchor));
+			}
+		}
+		if (numFrames > 1) kept.push_back(static_cast<uint32_t>(numFrames - 1));
+	}
+
+	ClipTrack track;
+	track.node = node;
+	track.type = type;
+	track.keyOffset = static_cast<uint32_t>(clip.keyData.size());
+	track.numKeys = static_cast<uint32_t>(kept.size());
+	track.segmentOffset = static_cast<uint32_t>(clip.segments.size());
+	for (int c = 0; c < 3; c++) {
+		track.rangeMin[c] = 0.0f;
+		track.rangeExtent[c] = 0.0f;
+	}
+
+	if (type != TRACK_ROTATION) {
+		for (int c = 0; c < 3; c++) {
+			float low = samples[kept[0]][c], high = low;
+			for (uint32_t frame : kept) {
+				low = std::min(low, samples[frame][c]);
+				high = std::max(high, samples[frame][c]);
+			}
+			track.rangeMin[c] = low;
+			track.rangeExtent[c] = high - low;
+		}
+	}
+
+	for (uint32_t frame : kept) {
+		clip.keyData.push_back(static_cast<uint16_t>(frame));
+		const glm::vec4& value = samples[frame];
+		if (type == TRACK_ROTATION) {
+			for (int c = 0; c < 4; c++) {
+				int16_t quantized = static_cast<int16_t>(std::round(glm::clamp(value[c], -1.0f, 1.0f) * 32767.0f));
+				clip.keyData.push_back(static_cast<uint16_t>(quantized));
+			}
+		}
+		else {
+			for (int c = 0; c < 3; c++) {
+				float unit = track.rangeExtent[c] > 0.0f ? (value[c] - track.rangeMin[c]) / track.rangeExtent[c] : 0.0f;
+				clip.keyData.push_back(static_cast<uint16_t>(std::round(glm::clamp(unit, 0.0f, 1.0f) * 65535.0f)));
+			}
+		}
+	}
+
+	// key every segment starts in, so sampling skips straight to it
+	uint32_t numSegments = (clip.frameCount - 1) / CLIP_SEGMENT_FRAMES + 1;
+	uint32_t key = 0;
+	for (uint32_t segment = 0; segment < numSegments; segment++) {
+		uint32_t frame = segment * CLIP_SEGMENT_FRAMES;
+		while (key + 1 < kept.size() && kept[key + 1] <= frame) key++;
+		clip.segments.push_back(static_cast<uint16_t>(key));
+	}
+
+	clip.tracks.push_back(track);
+}
+
+CompressedClip compressClip(const AnimationClip& clip, const LocalPose& bindPose, const ClipCompressionSettings& settings) {
+	CompressedClip compressed;
+	compressed.name = clip.name;
+
+	// files that leave the rate out are usually authored at 25 ticks per second
+	float ticksPerSecond = clip.ticksPerSecond > 0.0f ? clip.ticksPerSecond : 25.0f;
+	compressed.duration = std::max(clip.duration, 0.0f) / ticksPerSecond;
+
+	float frames = std::ceil(compressed.duration * CLIP_SAMPLE_RATE);
+	if (frames > CLIP_MAX_FRAMES - 1) {
+		std::cout << "ERROR::ANIMATION::CLIP_TOO_LONG, cut to " << CLIP_MAX_FRAMES << " frames: " << clip.name << std::endl;
+		frames = CLIP_MAX_FRAMES - 1;
+		compressed.duration = frames / CLIP_SAMPLE_RATE;
+	}
+	compressed.frameCount = static_cast<uint32_t>(frames) + 1;
+
+	std::vector<const AnimationChannel*> channels;
+	for (const AnimationChannel& channel : clip.channels) {
+		if (channel.node >= 0 && static_cast<size_t>(channel.node) < bindPose.count) channels.push_back(&channel);
+	}
+	std::sort(channels.begin(), channels.end(), [](const AnimationChannel* a, const AnimationChannel* b) { return a->node < b->node; });
+
+	std::vector<glm::vec4> samples(compressed.frameCount);
+	for (const AnimationChannel* channel : channels) {
+		size_t node = channel->node;
+		float tolerances[3] = { settings.translationError, settings.rotationError, settings.scaleError };
+		glm::vec4 binds[3] = {
+			glm::vec4(bindPose.tx[node], bindPose.ty[node], bindPose.tz[node], 0.0f),
+			glm::vec4(bindPose.rx[node], bindPose.ry[node], bindPose.rz[node], bindPose.rw[node]),
+			glm::vec4(bindPose.sx[node], bindPose.sy[node], bindPose.sz[node], 0.0f)
+		};
+
+		for (int type = TRACK_TRANSLATION; type <= TRACK_SCALE; type++) {
+			bool empty = type == TRACK_ROTATION ? channel->rotations.empty() : (type == TRACK_TRANSLATION ? channel->positions.empty() : channel->scales.empty());
+			if (empty) continue;
+
+			unsigned int cursor = 0;
+			for (uint32_t frame = 0; frame < compressed.frameCount; frame++) {
+				float ticks = std::min(frame / CLIP_SAMPLE_RATE, compressed.duration) * ticksPerSecond;
+				if (type == TRACK_ROTATION) {
+					samples[frame] = sampleRaw(channel->rotations, ticks, cursor);
+					// neighbouring keys on the same side of the hypersphere, so the sampler can lerp them directly
+					if (frame > 0 && dot4(samples[frame], samples[frame - 1]) < 0.0f) samples[frame] = samples[frame] * -1.0f;
+				}
+				else samples[frame] = sampleRaw(type == TRACK_TRANSLATION ? channel->positions : channel->scales, ticks, cursor);
+			}
+
+			addTrack(compressed, static_cast<uint32_t>(node), static_cast<ClipTrackType>(type), samples, binds[type], tolerances[type]);
+		}
+	}
+	return compressed;
+}
+
+
+void ClipSampler::resize(size_t nodes) {
+	next.resize(nodes);
+	translationAlpha.assign(next.count, 0.0f);
+	rotationAlpha.assign(next.count, 0.0f);
+	scaleAlpha.assign(next.count, 0.0f);
+}
+
+// out = a + (b - a) * t, with t per element or the same for all when null. out may alias a or b
+static void lerpArrays(const float* a, const float* b, const float* t, float constant, float* out, size_t count) {
+#ifdef CLIP_SSE
+	__m128 weight = _mm_set1_ps(constant);
+	for (size_t i = 0; i < count; i += 4) {
+		__m128 from = _mm_loadu_ps(a + i);
+		__m128 to = _mm_loadu_ps(b + i);
+		if (t) weight = _mm_loadu_ps(t + i);
+		_mm_storeu_ps(out + i, _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(to, from), weight)));
+	}
+#else
+	for (size_t i = 0; i < count; i++) {
+		float weight = t ? t[i] : constant;
+		out[i] = a[i] + (b[i] - a[i]) * weight;
+	}
+#endif
+}
+
+// normalized lerp of two quaternion arrays along the shortest arc, same weights and aliasing as lerpArrays
+static void nlerpArrays(const LocalPose& a, const LocalPose& b, const float* t, float constant, LocalPose& out) {
+#ifdef CLIP_SSE
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 signBit = _mm_set1_ps(-0.0f);
+	__m128 weight = _mm_set1_ps(constant);
+	for (size_t i = 0; i < out.count; i += 4) {
+		__m128 ax = _mm_loadu_ps(&a.rx[i]), ay = _mm_loadu_ps(&a.ry[i]), az = _mm_loadu_ps(&a.rz[i]), aw = _mm_loadu_ps(&a.rw[i]);
+		__m128 bx = _mm_loadu_ps(&b.rx[i]), by = _mm_loadu_ps(&b.ry[i]), bz = _mm_loadu_ps(&b.rz[i]), bw = _mm_loadu_ps(&b.rw[i]);
+		if (t) weight = _mm_loadu_ps(t + i);
+
+		// flip b where it is on the far side of a
+		__m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+		__m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, zero), signBit);
+		bx = _mm_xor_ps(bx, flip);
+		by = _mm_xor_ps(by, flip);
+		bz = _mm_xor_ps(bz, flip);
+		bw = _mm_xor_ps(bw, flip);
+
+		__m128 x = _mm_add_ps(ax, _mm_mul_ps(_mm_sub_ps(bx, ax), weight));
+		__m128 y = _mm_add_ps(ay, _mm_mul_ps(_mm_sub_ps(by, ay), weight));
+		__m128 z = _mm_add_ps(az, _mm_mul_ps(_mm_sub_ps(bz, az), weight));
+		__m128 w = _mm_add_ps(aw, _mm_mul_ps(_mm_sub_ps(bw, aw), weight));
+
+		__m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w))));
+		__m128 scale = _mm_div_ps(_mm_set1_ps(1.0f), length);
+		_mm_storeu_ps(&out.rx[i], _mm_mul_ps(x, scale));
+		_mm_storeu_ps(&out.ry[i], _mm_mul_ps(y, scale));
+		_mm_storeu_ps(&out.rz[i], _mm_mul_ps(z, scale));
+		_mm_storeu_ps(&out.rw[i], _mm_mul_ps(w, scale));
+	}
+#else
+	for (size_t i = 0; i < out.count; i++) {
+		float weight = t ? t[i] : constant;
+		float bx = b.rx[i], by = b.ry[i], bz = b.rz[i], bw = b.rw[i];
+		if (a.rx[i] * bx + a.ry[i] * by + a.rz[i] * bz + a.rw[i] * bw < 0.0f) {
+			bx = -bx;
+			by = -by;
+			bz = -bz;
+			bw = -bw;
+		}
+
+		float x = a.rx[i] + (bx - a.rx[i]) * weight;
+		float y = a.ry[i] + (by - a.ry[i]) * weight;
+		float z = a.rz[i] + (bz - a.rz[i]) * weight;
+		float w = a.rw[i] + (bw - a.rw[i]) * weight;
+		float scale = 1.0f / std::sqrt(x * x + y * y + z * z + w * w);
+		out.rx[i] = x * scale;
+		out.ry[i] = y * scale;
+		out.rz[i] = z * scale;
+		out.rw[i] = w * scale;
+	}
+#endif
+}
+
+void ClipSampler::sample(const CompressedClip& clip, float time, const LocalPose& bindPose, LocalPose& out) {
+	out.copyFrom(bindPose);
+	next.copyFrom(bindPose);
+	std::fill(translationAlpha.begin(), translationAlpha.end(), 0.0f);
+	std::fill(rotationAlpha.begin(), rotationAlpha.end(), 0.0f);
+	std::fill(scaleAlpha.begin(), scaleAlpha.end(), 0.0f);
+
+	float frame = glm::clamp(time * CLIP_SAMPLE_RATE, 0.0f, float(clip.frameCount - 1));
+	uint32_t wholeFrame = static_cast<uint32_t>(frame);
+	uint32_t segment = wholeFrame / CLIP_SEGMENT_FRAMES;
+
+	// gather the two keys around the frame of every track into out and next
+	for (const ClipTrack& track : clip.tracks) {
+		size_t stride = track.type == TRACK_ROTATION ? 5 : 4;
+		const uint16_t* keys = clip.keyData.data() + track.keyOffset;
+
+		// the segment table lands at most CLIP_SEGMENT_FRAMES keys before the frame
+		uint32_t key = clip.segments[track.segmentOffset + segment];
+		while (key + 1 < track.numKeys && keys[(key + 1) * stride] <= wholeFrame) key++;
+		uint32_t after = std::min(key + 1, track.numKeys - 1);
+
+		float alpha = 0.0f;
+		if (after != key) alpha = glm::clamp((frame - keys[key * stride]) / float(keys[after * stride] - keys[key * stride]), 0.0f, 1.0f);
+
+		const uint16_t* from = keys + key * stride + 1;
+		const uint16_t* to = keys + after * stride + 1;
+		size_t node = track.node;
+
+		if (track.type == TRACK_ROTATION) {
+			const float snorm = 1.0f / 32767.0f;
+			out.rx[node] = static_cast<int16_t>(from[0]) * snorm;
+			out.ry[node] = static_cast<int16_t>(from[1]) * snorm;
+			out.rz[node] = static_cast<int16_t>(from[2]) * snorm;
+			out.rw[node] = static_cast<int16_t>(from[3]) * snorm;
+			next.rx[node] = static_cast<int16_t>(to[0]) * snorm;
+			next.ry[node] = static_cast<int16_t>(to[1]) * snorm;
+			next.rz[node] = static_cast<int16_t>(to[2]) * snorm;
+			next.rw[node] = static_cast<int16_t>(to[3]) * snorm;
+			rotationAlpha[node] = alpha;
+			continue;
+		}
+
+		bool translation = track.type == TRACK_TRANSLATION;
+		float* outputs[3] = { translation ? &out.tx[node] : &out.sx[node], translation ? &out.ty[node] : &out.sy[node], translation ? &out.tz[node] : &out.sz[node] };
+		float* nexts[3] = { translation ? &next.tx[node] : &next.sx[node], translation ? &next.ty[node] : &next.sy[node], translation ? &next.tz[node] : &next.sz[node] };
+		for (int c = 0; c < 3; c++) {
+			float step = track.rangeExtent[c] / 65535.0f;
+			*outputs[c] = track.rangeMin[c] + from[c] * step;
+			*nexts[c] = track.rangeMin[c] + to[c] * step;
+		}
+		(translation ? translationAlpha : scaleAlpha)[node] = alpha;
+	}
+
+	// interpolate every node at once, untouched nodes have alpha 0 and keep the bind pose
+	lerpArrays(out.tx.data(), next.tx.data(), translationAlpha.data(), 0.0f, out.tx.data(), out.count);
+	lerpArrays(out.ty.data(), next.ty.data(), translationAlpha.data(), 0.0f, out.ty.data(), out.count);
+	lerpArrays(out.tz.data(), next.tz.data(), translationAlpha.data(), 0.0f, out.tz.data(), out.count);
+	nlerpArrays(out, next, rotationAlpha.data(), 0.0f, out);
+	lerpArrays(out.sx.data(), next.sx.data(), scaleAlpha.data(), 0.0f, out.sx.data(), out.count);
+	lerpArrays(out.sy.data(), next.sy.data(), scaleAlpha.data(), 0.0f, out.sy.data(), out.count);
+	lerpArrays(out.sz.data(), next.sz.data(), scaleAlpha.data(), 0.0f, out.sz.data(), out.count);
+}
+
+void blendPoses(const LocalPose& from, const LocalPose& to, float weight, LocalPose& out) {
+	lerpArrays(from.tx.data(), to.tx.data(), nullptr, weight, out.tx.data(), out.count);
+	lerpArrays(from.ty.data(), to.ty.data(), nullptr, weight, out.ty.data(), out.count);
+	lerpArrays(from.tz.data(), to.tz.data(), nullptr, weight, out.tz.data(), out.count);
+	nlerpArrays(from, to, nullptr, weight, out);
+	lerpArrays(from.sx.data(), to.sx.data(), nullptr, weight, out.sx.data(), out.count);
+	lerpArrays(from.sy.data(), to.sy.data(), nullptr, weight, out.sy.data(), out.count);
+	lerpArrays(from.sz.data(), to.sz.data(), nullptr, weight, out.sz.data(), out.count);
+}
+
+void poseToMatrices(const LocalPose& pose, size_t numNodes, glm::mat4* out) {
+	// rotation * scale columns of 4 nodes, 9 rows of 4 lanes
+	float basis[9][4];
+
+	for (size_t i = 0; i < numNodes; i += 4) {
+#ifdef CLIP_SSE
+		__m128 x = _mm_loadu_ps(&pose.rx[i]), y = _mm_loadu_ps(&pose.ry[i]), z = _mm_loadu_ps(&pose.rz[i]), w = _mm_loadu_ps(&pose.rw[i]);
+		__m128 sx = _mm_loadu_ps(&pose.sx[i]), sy = _mm_loadu_ps(&pose.sy[i]), sz = _mm_loadu_ps(&pose.sz[i]);
+		__m128 one = _mm_set1_ps(1.0f), two = _mm_set1_ps(2.0f);
+
+		__m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+		__m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+		__m128 wx = _mm_mul_ps(w, x), wy = _mm_mul_ps(w, y), wz = _mm_mul_ps(w, z);
+
+		_mm_storeu_ps(basis[0], _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx));
+		_mm_storeu_ps(basis[1], _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx));
+		_mm_storeu_ps(basis[2], _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx));
+		_mm_storeu_ps(basis[3], _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy));
+		_mm_storeu_ps(basis[4], _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy));
+		_mm_storeu_ps(basis[5], _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy));
+		_mm_storeu_ps(basis[6], _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz));
+		_mm_storeu_ps(basis[7], _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz));
+		_mm_storeu_ps(basis[8], _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz));
+#else
+		for (size_t lane = 0; lane < 4; lane++) {
+			size_t n = i + lane;
+			float x = pose.rx[n], y = pose.ry[n], z = pose.rz[n], w = pose.rw[n];
+			basis[0][lane] = (1.0f - 2.0f * (y * y + z * z)) * pose.sx[n];
+			basis[1][lane] = 2.0f * (x * y + w * z) * pose.sx[n];
+			basis[2][lane] = 2.0f * (x * z - w * y) * pose.sx[n];
+			basis[3][lane] = 2.0f * (x * y - w * z) * pose.sy[n];
+			basis[4][lane] = (1.0f - 2.0f * (x * x + z * z)) * pose.sy[n];
+			basis[5][lane] = 2.0f * (y * z + w * x) * pose.sy[n];
+			basis[6][lane] = 2.0f * (x * z + w * y) * pose.sz[n];
+			basis[7][lane] = 2.0f * (y * z - w * x) * pose.sz[n];
+			basis[8][lane] = (1.0f - 2.0f * (x * x + y * y)) * pose.sz[n];
+		}
+#endif
+
+		size_t lanes = std::min(numNodes - i, size_t(4));
+		for (size_t lane = 0; lane < lanes; lane++) {
+			glm::mat4& matrix = out[i + lane];
+			matrix[0] = glm::vec4(basis[0][lane], basis[1][lane], basis[2][lane], 0.0f);
+			matrix[1] = glm::vec4(basis[3][lane], basis[4][lane], basis[5][lane], 0.0f);
+			matrix[2] = glm::vec4(basis[6][lane], basis[7][lane], basis[8][lane], 0.0f);
+			matrix[3] = glm::vec4(pose.tx[i + lane], pose.ty[i + lane], pose.tz[i + lane], 1.0f);
+		}
+	}
+}
@@ -0,0 +1,127 @@
+#ifndef ANIMATION_CLIP_H
+#define ANIMATION_CLIP_H
+
+#include <glm/glm/glm.hpp>
+#include <glm/glm/gtc/quaternion.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// raw curves are resampled at this rate before key reduction, key times are frame numbers at this rate
+#define CLIP_SAMPLE_RATE 30.0f
+// frames per seek segment, sampling never scans more keys than this whatever the clip length
+#define CLIP_SEGMENT_FRAMES 16
+// frame numbers are 16 bit, longer clips are cut (36 minutes at 30 fps)
+#define CLIP_MAX_FRAMES 65535
+
+
+// keyframes as assimp imports them, only kept until the clip is compressed
+struct VectorKey {
+	float time;		// in ticks
+	glm::vec3 value;
+};
+
+struct RotationKey {
+	float time;
+	glm::quat value;
+};
+
+// keyframes of one animated node
+struct AnimationChannel {
+	int node;	// index in Skeleton::nodes
+	std::vector<VectorKey> positions;
+	std::vector<RotationKey> rotations;
+	std::vector<VectorKey> scales;
+};
+
+struct AnimationClip {
+	std::string name;
+	float duration;			// in ticks
+	float ticksPerSecond;
+	std::vector<AnimationChannel> channels;
+};
+
+
+enum ClipTrackType {
+	TRACK_TRANSLATION,
+	TRACK_ROTATION,
+	TRACK_SCALE
+};
+
+// one key reduced curve of a node. Keys are runs of uint16 words, the frame number followed by
+// 3 unorm16 components inside [rangeMin, rangeMin + rangeExtent] for translation and scale,
+// or 4 snorm16 quaternion components for rotation. Plain data, written to the cache as it is
+struct ClipTrack {
+	uint32_t node;
+	uint32_t type;			// ClipTrackType
+	uint32_t keyOffset;		// first word in CompressedClip::keyData
+	uint32_t numKeys;
+	uint32_t segmentOffset;	// first entry in CompressedClip::segments
+	float rangeMin[3];
+	float rangeExtent[3];
+};
+
+// animation resampled at CLIP_SAMPLE_RATE, with the keys linear interpolation can rebuild dropped
+// and the rest quantized. Nodes that stay at their bind pose have no track at all
+struct CompressedClip {
+	std::string name;
+	float duration = 0.0f;			// in seconds
+	uint32_t frameCount = 1;		// frame frameCount - 1 is at duration
+	std::vector<ClipTrack> tracks;	// ordered by node
+	std::vector<uint16_t> keyData;
+	std::vector<uint16_t> segments;	// per track and segment, the key the segment starts in
+
+	size_t memory() const;
+};
+
+// how far a dropped key may be off from the interpolation of the kept ones
+struct ClipCompressionSettings {
+	float translationError = 0.0005f;	// model units
+	float rotationError = 0.0005f;		// per quaternion component
+	float scaleError = 0.0005f;
+};
+
+// local transform of every node as a structure of arrays, padded to a multiple of 4 with identities for the SIMD passes
+struct LocalPose {
+	size_t count = 0;
+	std::vector<float> tx, ty, tz;
+	std::vector<float> rx, ry, rz, rw;
+	std::vector<float> sx, sy, sz;
+
+	void resize(size_t nodes);
+	void copyFrom(const LocalPose& other);	// same size, doesn't allocate
+	void set(size_t node, const glm::vec3& translation, const glm::quat& rotation, const glm::vec3& scale);
+};
+
+// split an affine transform into translation, rotation and scale
+void decomposeTransform(const glm::mat4& transform, glm::vec3& translation, glm::quat& rotation, glm::vec3& scale);
+
+// resample, key reduce and quantize an imported clip, bindPose holds one entry per skeleton node
+CompressedClip compressClip(const AnimationClip& clip, const LocalPose& bindPose, const ClipCompressionSettings& settings = ClipCompressionSettings());
+
+// bytes the raw keys of a clip take, to compare against CompressedClip::memory()
+size_t rawClipMemory(const AnimationClip& clip);
+
+// Evaluates compressed clips into LocalPoses. Every track finds its keys through the segment table,
+// then one SIMD pass interpolates all nodes at once, so the cost follows the node count and not the
+// clip length. Owns the scratch of that pass, sized once per skeleton so sampling doesn't allocate
+class ClipSampler {
+public:
+	void resize(size_t nodes);
+
+	// nodes the clip doesn't animate get their bind pose. time is in seconds, clamped to the clip
+	void sample(const CompressedClip& clip, float time, const LocalPose& bindPose, LocalPose& out);
+
+private:
+	LocalPose next;		// the key after the one out starts from, per node
+	std::vector<float> translationAlpha, rotationAlpha, scaleAlpha;
+};
+
+// out = from * (1 - weight) + to * weight, rotations nlerped along the shortest arc. out may alias either input
+void blendPoses(const LocalPose& from, const LocalPose& to, float weight, LocalPose& out);
+
+// translate * rotate * scale of the first numNodes nodes
+void poseToMatrices(const LocalPose& pose, size_t numNodes, glm::mat4* out);
+
+#endif
@@ -0,0 +1,138 @@
+#include "animator.h"
+
+#include <algorithm>
+#include <cmath>
+
+Animator::Animator(std::shared_ptr<const Skeleton> skeleton) : rig(skeleton) {
+	if (!rig) return;
+
+	sampler.resize(rig->nodes.size());
+	pose.resize(rig->nodes.size());
+	fadePose.resize(rig->nodes.size());
+	locals.resize(rig->nodes.size());
+	globals.resize(rig->nodes.size());
+	bones.assign(rig->boneCount(), glm::mat4(1.0f));
+
+	update(0.0f); // bind pose until a clip is played
+}
+
+Animator::~Animator() {
+	if (UBO) glDeleteBuffers(1, &UBO);
+}
+
+Animator::Animator(Animator&& other) noexcept
+	: rig(std::move(other.rig)), current(other.current), previous(other.previous), fadeTime(other.fadeTime), fadeDuration(other.fadeDuration),
+	sampler(std::move(other.sampler)), pose(std::move(other.pose)), fadePose(std::move(other.fadePose)),
+	locals(std::move(other.locals)), globals(std::move(other.globals)), bones(std::move(other.bones)),
+	UBO(other.UBO), paletteDirty(other.paletteDirty), boundProgram(other.boundProgram) {
+	other.UBO = 0;
+}
+
+Animator& Animator::operator=(Animator&& other) noexcept {
+	if (this != &other) {
+		if (UBO) glDeleteBuffers(1, &UBO);
+		rig = std::move(other.rig);
+		current = other.current;
+		previous = other.previous;
+		fadeTime = other.fadeTime;
+		fadeDuration = other.fadeDuration;
+		sampler = std::move(other.sampler);
+		pose = std::move(other.pose);
+		fadePose = std::move(other.fadePose);
+		locals = std::move(other.locals);
+		globals = std::move(other.globals);
+		bones = std::move(other.bones);
+		UBO = other.UBO;
+		paletteDirty = other.paletteDirty;
+		boundProgram = other.boundProgram;
+		other.UBO = 0;
+	}
+	return *this;
+}
+
+void Animator::play(int clipIndex, bool looping) {
+	if (!rig || clipIndex >= static_cast<int>(rig->clips.size())) clipIndex = -1;
+	current.clip = clipIndex;
+	current.loop = looping;
+	current.time = 0.0f;
+	fadeDuration = 0.0f;
+}
+
+void Animator::crossFade(int clipIndex, float seconds, bool looping) {
+	Playback from = current;
+	play(clipIndex, looping);
+	if (seconds <= 0.0f) return;
+
+	previous = from;
+	fadeTime = 0.0f;
+	fadeDuration = seconds;
+}
+
+void Animator::advance(Playback& playback, float deltaTime) const {
+	if (playback.clip < 0) return;
+	const CompressedClip& clip = rig->clips[playback.clip];
+
+	playback.time += deltaTime;
+	if (clip.duration > 0.0f) playback.time = playback.loop ? std::fmod(playback.time, clip.duration) : std::min(playback.time, clip.duration);
+	else playback.time = 0.0f;
+}
+
+void Animator::samplePlayback(const Playback& playback, LocalPose& out) {
+	if (playback.clip < 0) out.copyFrom(rig->bindPose);
+	else sampler.sample(rig->clips[playback.clip], playback.time, rig->bindPose, out);
+}
+
+void Animator::update(float deltaTime) {
+	if (!rig) return;
+	const Skeleton& skeleton = *rig;
+
+	advance(current, deltaTime);
+	samplePlayback(current, pose);
+
+	if (fadeDuration > 0.0f) {
+		advance(previous, deltaTime);
+		fadeTime += deltaTime;
+		if (fadeTime >= fadeDuration) fadeDuration = 0.0f;
+		else {
+			samplePlayback(previous, fadePose);
+			blendPoses(fadePose, pose, fadeTime / fadeDuration, pose);
+		}
+	}
+
+	poseToMatrices(pose, skeleton.nodes.size(), locals.data());
+
+	// parents come first, so their globals are final by the time a child reads them
+	for (size_t i = 0; i < skeleton.nodes.size(); i++) {
+		const SkeletonNode& node = skeleton.nodes[i];
+		globals[i] = node.parent < 0 ? locals[i] : globals[node.parent] * locals[i];
+		if (node.bone >= 0) bones[node.bone] = skeleton.globalInverse * globals[i] * skeleton.boneOffsets[node.bone];
+	}
+	paletteDirty = true;
+}
+
+void Animator::bindPalette(Shader& shader) {
+	if (!rig || bones.empty()) return;
+
+	if (!UBO) {
+		glGenBuffers(1, &UBO);
+		glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+		glBufferData(GL_UNIFORM_BUFFER, MAX_BONES * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+		paletteDirty = true;
+	}
+
+	if (paletteDirty) {
+		// bigger skeletons are skinned on the CPU, only the first MAX_BONES fit the block
+		size_t count = std::min(bones.size(), static_cast<size_t>(MAX_BONES));
+		glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, count * sizeof(glm::mat4), bones.data());
+		paletteDirty = false;
+	}
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	if (boundProgram != shader.ID) {
+		unsigned int block = shader.uniformBlock("BonePalette");
+		if (block != GL_INVALID_INDEX) glUniformBlockBinding(shader.ID, block, BONE_PALETTE_BINDING);
+		boundProgram = shader.ID;
+	}
+	glBindBufferBase(GL_UNIFORM_BUFFER, BONE_PALETTE_BINDING, UBO);
+}
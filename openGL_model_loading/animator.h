@@ -0,0 +1,79 @@
+#ifndef ANIMATOR_H
+#define ANIMATOR_H
+
+#include <glad/glad.h>
+
+#include "shader_class.h"
+#include "skeleton.h"
+
+#include <memory>
+#include <vector>
+
+// uniform buffer binding point of the BonePalette block
+#define BONE_PALETTE_BINDING 0
+
+// Playback state of one animated character: the clip, its time and the bone palette it produces.
+// Every buffer is sized for the skeleton up front so update() and bindPalette() never allocate,
+// any number of Animators can share one Skeleton and its compressed clips
+class Animator {
+public:
+	Animator() {}
+	explicit Animator(std::shared_ptr<const Skeleton> skeleton);
+	~Animator();
+
+	Animator(const Animator&) = delete;
+	Animator& operator=(const Animator&) = delete;
+	Animator(Animator&& other) noexcept;
+	Animator& operator=(Animator&& other) noexcept;
+
+	// restart playback with a clip of the skeleton, -1 holds the bind pose
+	void play(int clip, bool loop = true);
+
+	// start a clip and blend over to it from the current pose within seconds
+	void crossFade(int clip, float seconds, bool loop = true);
+
+	int currentClip() const { return current.clip; }
+	float currentTime() const { return current.time; }	// in seconds
+
+	// advance the clip and rebuild the palette, CPU only so it can run on any thread
+	void update(float deltaTime);
+
+	// palette[bone] takes mesh space bind pose positions to the animated pose
+	const std::vector<glm::mat4>& palette() const { return bones; }
+	const Skeleton* skeleton() const { return rig.get(); }
+
+	// local transform of every skeleton node in the current pose
+	const std::vector<glm::mat4>& nodeLocals() const { return locals; }
+
+	// upload the palette when it changed and bind it for shader's BonePalette block, GL thread only
+	void bindPalette(Shader& shader);
+
+private:
+	struct Playback {
+		int clip = -1;
+		float time = 0.0f;	// in seconds
+		bool loop = true;
+	};
+
+	std::shared_ptr<const Skeleton> rig;
+	Playback current;
+	Playback previous;			// blended out while a cross fade runs
+	float fadeTime = 0.0f;
+	float fadeDuration = 0.0f;	// 0 when no cross fade runs
+
+	ClipSampler sampler;
+	LocalPose pose;					// per node
+	LocalPose fadePose;				// previous clip's pose during a cross fade
+	std::vector<glm::mat4> locals;	// per node
+	std::vector<glm::mat4> globals;
+	std::vector<glm::mat4> bones;	// per palette slot
+
+	unsigned int UBO = 0;
+	bool paletteDirty = true;
+	unsigned int boundProgram = 0;	// program whose BonePalette block was last pointed at BONE_PALETTE_BINDING
+
+	void advance(Playback& playback, float deltaTime) const;
+	void samplePlayback(const Playback& playback, LocalPose& out);
+};
+
+#endif
@@ -0,0 +1,74 @@
+// Command line cooker, a separate executable next to the viewer. Build it from this file plus the
+// chapter's sources without Main.cpp, it needs no window or GL context.
+//
+//   asset_cooker <model> [-o out.pkg] [--optimize] [--lod 0.5,0.25] [--quality fast|normal|high] [--no-compress] [--force]
+//
+// The package goes next to the model by default, backpack/backpack.obj -> backpack/backpack.pkg,
+// so the texture paths it stores resolve the same way. Running it again only redoes what changed.
+
+#include "model_package.h"
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+static void printUsage() {
+	std::cout << "usage: asset_cooker <model> [-o out" MODEL_PACKAGE_EXTENSION "] [--optimize] [--lod r0,r1,...] [--quality fast|normal|high] [--no-compress] [--force]" << std::endl;
+}
+
+int main(int argc, char** argv) {
+	std::string modelPath, packagePath;
+	CookSettings settings;
+
+	for (int i = 1; i < argc; i++) {
+		if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) packagePath = argv[++i];
+		else if (std::strcmp(argv[i], "--optimize") == 0) settings.optimizeMeshes = true;
+		else if (std::strcmp(argv[i], "--no-compress") == 0) settings.compressTextures = false;
+		else if (std::strcmp(argv[i], "--force") == 0) settings.force = true;
+		else if (std::strcmp(argv[i], "--quality") == 0 && i + 1 < argc) {
+			std::string quality = argv[++i];
+			if (quality == "fast") settings.quality = COMPRESSION_FAST;
+			else if (quality == "normal") settings.quality = COMPRESSION_NORMAL;
+			else if (quality == "high") settings.quality = COMPRESSION_HIGH;
+			else {
+				printUsage();
+				return 1;
+			}
+		}
+		else if (std::strcmp(argv[i], "--lod") == 0 && i + 1 < argc) {
+			std::stringstream ratios(argv[++i]);
+			std::string ratio;
+			while (std::getline(ratios, ratio, ',')) {
+				// a ratio is a share of the triangles, anything that isn't a number in (0, 1] is a typo
+				size_t parsed = 0;
+				float value = 0.0f;
+				try {
+					value = std::stof(ratio, &parsed);
+				}
+				catch (const std::exception&) {
+					parsed = 0;
+				}
+				if (parsed == 0 || parsed != ratio.size() || !(value > 0.0f && value <= 1.0f)) {
+					printUsage();
+					return 1;
+				}
+				settings.lodRatios.push_back(value);
+			}
+		}
+		else if (argv[i][0] != '-' && modelPath.empty()) modelPath = argv[i];
+		else {
+			printUsage();
+			return 1;
+		}
+	}
+
+	if (modelPath.empty()) {
+		printUsage();
+		return 1;
+	}
+	if (packagePath.empty()) packagePath = modelPath.substr(0, modelPath.find_last_of('.')) + MODEL_PACKAGE_EXTENSION;
+
+	return cookModelPackage(modelPath, packagePath, settings) ? 0 : 1;
+}
@@ -0,0 +1,645 @@
+#include "block_compress.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BLOCK_COMPRESS_SSE
+#endif
+
+size_t blockBytes(BlockFormat format) {
+	switch (format) {
+	case BLOCK_FORMAT_BC1: return 8;
+	case BLOCK_FORMAT_BC3: return 16;
+	case BLOCK_FORMAT_BC5: return 16;
+	case BLOCK_FORMAT_BC7: return 16;
+	default: return 0;
+	}
+}
+
+size_t compressedSize(BlockFormat format, int width, int height) {
+	return static_cast<size_t>((width + 3) / 4) * static_cast<size_t>((height + 3) / 4) * blockBytes(format);
+}
+
+GLenum blockInternalFormat(BlockFormat format) {
+	switch (format) {
+	case BLOCK_FORMAT_BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	case BLOCK_FORMAT_BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	case BLOCK_FORMAT_BC5: return GL_COMPRESSED_RG_RGTC2;
+	case BLOCK_FORMAT_BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+	default: return GL_RGBA8;
+	}
+}
+
+bool validBlockFormat(uint32_t format) {
+	return format == BLOCK_FORMAT_NONE || format == BLOCK_FORMAT_BC1 || format == BLOCK_FORMAT_BC3 || format == BLOCK_FORMAT_BC5 || format == BLOCK_FORMAT_BC7;
+}
+
+BlockFormat chooseBlockFormat(bool normalMap, bool hasAlpha, CompressionQuality quality, bool allowBC7) {
+	if (normalMap) return BLOCK_FORMAT_BC5;
+	if (hasAlpha) return BLOCK_FORMAT_BC3;
+	return quality == COMPRESSION_HIGH && allowBC7 ? BLOCK_FORMAT_BC7 : BLOCK_FORMAT_BC1;
+}
+
+size_t CompressedImage::uncompressedBytes() const {
+	size_t bytes = 0;
+	for (const CompressedMip& mip : mips) bytes += static_cast<size_t>(mip.width) * mip.height * 4;
+	return bytes;
+}
+
+// the 16 pixels of a block as floats, one array per channel so four pixels fill a register
+struct BlockPixels {
+	alignas(16) float channel[4][16];
+};
+
+// the 4x4 pixels at block (bx, by), clamped to the image
+static void loadBlock(const unsigned char* rgba, int width, int height, int bx, int by, BlockPixels& px) {
+	for (int y = 0; y < 4; y++) {
+		int sy = std::min(by * 4 + y, height - 1);
+		for (int x = 0; x < 4; x++) {
+			int sx = std::min(bx * 4 + x, width - 1);
+			const unsigned char* pixel = rgba + (static_cast<size_t>(sy) * width + sx) * 4;
+			for (int c = 0; c < 4; c++) px.channel[c][y * 4 + x] = pixel[c];
+		}
+	}
+}
+
+static void storeBlock(const unsigned char block[64], int width, int height, int bx, int by, unsigned char* rgba) {
+	for (int y = 0; y < 4 && by * 4 + y < height; y++) {
+		for (int x = 0; x < 4 && bx * 4 + x < width; x++) {
+			std::memcpy(rgba + (static_cast<size_t>(by * 4 + y) * width + bx * 4 + x) * 4, block + (y * 4 + x) * 4, 4);
+		}
+	}
+}
+
+// nearest palette entry of every pixel over channels [first, first + count), returns the summed squared error.
+// Every encoder spends most of its time here, four pixels are tested per step
+static float fitIndices(const BlockPixels& px, int first, int count, const float palette[][4], int paletteSize, uint8_t indices[16]) {
+	float total = 0.0f;
+#ifdef BLOCK_COMPRESS_SSE
+	for (int group = 0; group < 16; group += 4) {
+		__m128 best = _mm_set1_ps(1e30f);
+		__m128i bestIndex = _mm_setzero_si128();
+		for (int p = 0; p < paletteSize; p++) {
+			__m128 error = _mm_setzero_ps();
+			for (int c = first; c < first + count; c++) {
+				__m128 d = _mm_sub_ps(_mm_load_ps(px.channel[c] + group), _mm_set1_ps(palette[p][c]));
+				error = _mm_add_ps(error, _mm_mul_ps(d, d));
+			}
+			__m128i closer = _mm_castps_si128(_mm_cmplt_ps(error, best));
+			best = _mm_min_ps(error, best);
+			bestIndex = _mm_or_si128(_mm_and_si128(closer, _mm_set1_epi32(p)), _mm_andnot_si128(closer, bestIndex));
+		}
+
+		alignas(16) int32_t lanes[4];
+		alignas(16) float errors[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), bestIndex);
+		_mm_store_ps(errors, best);
+		for (int i = 0; i < 4; i++) {
+			indices[group + i] = static_cast<uint8_t>(lanes[i]);
+			total += errors[i];
+		}
+	}
+#else
+	for (int i = 0; i < 16; i++) {
+		float best = 1e30f;
+		int bestIndex = 0;
+		for (int p = 0; p < paletteSize; p++) {
+			float error = 0.0f;
+			for (int c = first; c < first + count; c++) {
+				float d = px.channel[c][i] - palette[p][c];
+				error += d * d;
+			}
+			if (error < best) {
+				best = error;
+				bestIndex = p;
+			}
+		}
+		indices[i] = static_cast<uint8_t>(bestIndex);
+		total += best;
+	}
+#endif
+	return total;
+}
+
+// per channel min and max, slightly inset since the extremes are rarely hit exactly
+static void boxEndpoints(const BlockPixels& px, int first, int count, float end0[4], float end1[4]) {
+	for (int c = first; c < first + count; c++) {
+		float low = px.channel[c][0], high = px.channel[c][0];
+		for (int i = 1; i < 16; i++) {
+			low = std::min(low, px.channel[c][i]);
+			high = std::max(high, px.channel[c][i]);
+		}
+		float inset = (high - low) / 16.0f;
+		end0[c] = high - inset;
+		end1[c] = low + inset;
+	}
+}
+
+// the ends of the pixels' principal axis, found with a few power iterations on their covariance
+static void axisEndpoints(const BlockPixels& px, int first, int count, float end0[4], float end1[4]) {
+	float mean[4] = {}, low[4], high[4];
+	for (int c = first; c < first + count; c++) {
+		low[c] = high[c] = px.channel[c][0];
+		for (int i = 0; i < 16; i++) {
+			mean[c] += px.channel[c][i];
+			low[c] = std::min(low[c], px.channel[c][i]);
+			high[c] = std::max(high[c], px.channel[c][i]);
+		}
+		mean[c] /= 16.0f;
+	}
+
+	float covariance[4][4] = {};
+	for (int i = 0; i < 16; i++) {
+		for (int a = first; a < first + count; a++) {
+			for (int b = first; b < first + count; b++) covariance[a][b] += (px.channel[a][i] - mean[a]) * (px.channel[b][i] - mean[b]);
+		}
+	}
+
+	// the box diagonal is a good first guess and never orthogonal to a one channel gradient
+	float axis[4] = {};
+	for (int c = first; c < first + count; c++) axis[c] = high[c] - low[c] + 1e-3f;
+	for (int iteration = 0; iteration < 4; iteration++) {
+		float next[4] = {}, length = 0.0f;
+		for (int a = first; a < first + count; a++) {
+			for (int b = first; b < first + count; b++) next[a] += covariance[a][b] * axis[b];
+			length += next[a] * next[a];
+		}
+		length = std::sqrt(length);
+		if (length < 1e-6f) break;
+		for (int c = first; c < first + count; c++) axis[c] = next[c] / length;
+	}
+
+	float minT = 0.0f, maxT = 0.0f;
+	for (int i = 0; i < 16; i++) {
+		float t = 0.0f;
+		for (int c = first; c < first + count; c++) t += (px.channel[c][i] - mean[c]) * axis[c];
+		minT = std::min(minT, t);
+		maxT = std::max(maxT, t);
+	}
+	for (int c = first; c < first + count; c++) {
+		end0[c] = std::min(std::max(mean[c] + axis[c] * maxT, 0.0f), 255.0f);
+		end1[c] = std::min(std::max(mean[c] + axis[c] * minT, 0.0f), 255.0f);
+	}
+}
+
+// least squares endpoints for fixed indices, weights[i] is how far palette entry i lies from end0 to end1.
+// Entries with a negative weight aren't on the line and are left out. False when the system is singular
+static bool refineEndpoints(const BlockPixels& px, int first, int count, const uint8_t indices[16], const float* weights, float end0[4], float end1[4]) {
+	float a = 0.0f, b = 0.0f, c = 0.0f, x0[4] = {}, x1[4] = {};
+	for (int i = 0; i < 16; i++) {
+		float w = weights[indices[i]];
+		if (w < 0.0f) continue;
+		a += (1.0f - w) * (1.0f - w);
+		b += (1.0f - w) * w;
+		c += w * w;
+		for (int ch = first; ch < first + count; ch++) {
+			x0[ch] += (1.0f - w) * px.channel[ch][i];
+			x1[ch] += w * px.channel[ch][i];
+		}
+	}
+
+	float det = a * c - b * b;
+	if (std::fabs(det) < 1e-4f) return false;
+	for (int ch = first; ch < first + count; ch++) {
+		end0[ch] = std::min(std::max((c * x0[ch] - b * x1[ch]) / det, 0.0f), 255.0f);
+		end1[ch] = std::min(std::max((a * x1[ch] - b * x0[ch]) / det, 0.0f), 255.0f);
+	}
+	return true;
+}
+
+static int refinementPasses(CompressionQuality quality) {
+	return quality == COMPRESSION_FAST ? 0 : quality == COMPRESSION_NORMAL ? 1 : 3;
+}
+
+
+// BC1 color
+
+static const float COLOR_WEIGHTS_4[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+static const float COLOR_WEIGHTS_3[4] = { 0.0f, 1.0f, 0.5f, -1.0f };
+
+static uint16_t to565(const float color[3]) {
+	int r = std::min(std::max(static_cast<int>(color[0] * 31.0f / 255.0f + 0.5f), 0), 31);
+	int g = std::min(std::max(static_cast<int>(color[1] * 63.0f / 255.0f + 0.5f), 0), 63);
+	int b = std::min(std::max(static_cast<int>(color[2] * 31.0f / 255.0f + 0.5f), 0), 31);
+	return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+static void from565(uint16_t color, int out[3]) {
+	int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+	out[0] = (r << 3) | (r >> 2);
+	out[1] = (g << 2) | (g >> 4);
+	out[2] = (b << 3) | (b >> 2);
+}
+
+// the four colors a BC1 block can pick from, three plus transparent black when c0 <= c1
+static void colorPalette(uint16_t c0, uint16_t c1, bool fourColors, int palette[4][4]) {
+	from565(c0, palette[0]);
+	from565(c1, palette[1]);
+	for (int c = 0; c < 3; c++) {
+		if (fourColors) {
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		}
+		else {
+			palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+			palette[3][c] = 0;
+		}
+	}
+	palette[0][3] = palette[1][3] = palette[2][3] = 255;
+	palette[3][3] = fourColors ? 255 : 0;
+}
+
+// quantize the endpoints, pick the indices and write the block. The indices come back in the order
+// of the written palette so refineEndpoints can continue from them
+static float encodeColorEndpoints(const BlockPixels& px, const float end0[4], const float end1[4], bool threeColors, unsigned char out[8], uint8_t indices[16]) {
+	uint16_t c0 = to565(end0), c1 = to565(end1);
+	if (threeColors ? c0 > c1 : c0 < c1) std::swap(c0, c1);
+
+	int colors[4][4];
+	colorPalette(c0, c1, !threeColors && c0 != c1, colors);
+	float palette[4][4];
+	for (int p = 0; p < 4; p++) {
+		for (int c = 0; c < 4; c++) palette[p][c] = static_cast<float>(colors[p][c]);
+	}
+
+	// equal endpoints decode in three color mode, only the first entry is safe to use
+	float error = fitIndices(px, 0, 3, palette, c0 == c1 ? 1 : 4, indices);
+
+	uint32_t bits = 0;
+	for (int i = 0; i < 16; i++) bits |= static_cast<uint32_t>(indices[i]) << (i * 2);
+	out[0] = c0 & 0xff;
+	out[1] = c0 >> 8;
+	out[2] = c1 & 0xff;
+	out[3] = c1 >> 8;
+	for (int b = 0; b < 4; b++) out[4 + b] = (bits >> (b * 8)) & 0xff;
+	return error;
+}
+
+// endpoints from the preset, then least squares passes for as long as they lower the error
+static float encodeColorMode(const BlockPixels& px, CompressionQuality quality, bool threeColors, unsigned char out[8]) {
+	float end0[4], end1[4];
+	if (quality == COMPRESSION_FAST) boxEndpoints(px, 0, 3, end0, end1);
+	else axisEndpoints(px, 0, 3, end0, end1);
+
+	uint8_t indices[16];
+	float best = encodeColorEndpoints(px, end0, end1, threeColors, out, indices);
+	for (int pass = 0; pass < refinementPasses(quality); pass++) {
+		if (!refineEndpoints(px, 0, 3, indices, threeColors ? COLOR_WEIGHTS_3 : COLOR_WEIGHTS_4, end0, end1)) break;
+
+		unsigned char candidate[8];
+		uint8_t candidateIndices[16];
+		float error = encodeColorEndpoints(px, end0, end1, threeColors, candidate, candidateIndices);
+		if (error >= best) break;
+		best = error;
+		std::memcpy(out, candidate, 8);
+		std::memcpy(indices, candidateIndices, 16);
+	}
+	return best;
+}
+
+// the three color mode is only allowed in plain BC1, BC3 decoders always read four colors
+static void encodeColorBlock(const BlockPixels& px, CompressionQuality quality, bool allowThreeColors, unsigned char out[8]) {
+	float best = encodeColorMode(px, quality, false, out);
+	if (allowThreeColors && quality == COMPRESSION_HIGH && best > 0.0f) {
+		unsigned char candidate[8];
+		if (encodeColorMode(px, quality, true, candidate) < best) std::memcpy(out, candidate, 8);
+	}
+}
+
+
+// BC3 alpha and BC5 channels, one value interpolated between two endpoints
+
+static const float ALPHA_WEIGHTS_8[8] = { 0.0f, 1.0f, 1.0f / 7.0f, 2.0f / 7.0f, 3.0f / 7.0f, 4.0f / 7.0f, 5.0f / 7.0f, 6.0f / 7.0f };
+
+// the eight values of an alpha block, interpolated between a0 > a1 or six of them plus 0 and 255
+static void alphaPalette(int a0, int a1, int palette[8]) {
+	palette[0] = a0;
+	palette[1] = a1;
+	if (a0 > a1) {
+		for (int i = 1; i < 7; i++) palette[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+	}
+	else {
+		for (int i = 1; i < 5; i++) palette[i + 1] = ((5 - i) * a0 + i * a1) / 5;
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+}
+
+static float encodeAlphaEndpoints(const BlockPixels& px, int channel, int a0, int a1, unsigned char out[8], uint8_t indices[16]) {
+	int values[8];
+	alphaPalette(a0, a1, values);
+	float palette[8][4];
+	for (int p = 0; p < 8; p++) palette[p][channel] = static_cast<float>(values[p]);
+
+	float error = fitIndices(px, channel, 1, palette, 8, indices);
+
+	uint64_t bits = 0;
+	for (int i = 0; i < 16; i++) bits |= static_cast<uint64_t>(indices[i]) << (i * 3);
+	out[0] = static_cast<unsigned char>(a0);
+	out[1] = static_cast<unsigned char>(a1);
+	for (int b = 0; b < 6; b++) out[2 + b] = (bits >> (b * 8)) & 0xff;
+	return error;
+}
+
+static int roundChannel(float value) {
+	return std::min(std::max(static_cast<int>(value + 0.5f), 0), 255);
+}
+
+static void encodeAlphaBlock(const BlockPixels& px, int channel, CompressionQuality quality, unsigned char out[8]) {
+	const float* values = px.channel[channel];
+	float low = values[0], high = values[0];
+	float innerLow = 255.0f, innerHigh = 0.0f;	// without the 0 and 255 the six value mode stores for free
+	for (int i = 0; i < 16; i++) {
+		low = std::min(low, values[i]);
+		high = std::max(high, values[i]);
+		if (values[i] > 0.0f && values[i] < 255.0f) {
+			innerLow = std::min(innerLow, values[i]);
+			innerHigh = std::max(innerHigh, values[i]);
+		}
+	}
+
+	uint8_t indices[16];
+	float best = encodeAlphaEndpoints(px, channel, roundChannel(high), roundChannel(low), out, indices);
+	if (best == 0.0f) return;
+
+	float end0[4], end1[4];
+	end0[channel] = high;
+	end1[channel] = low;
+	for (int pass = 0; pass < refinementPasses(quality); pass++) {
+		if (!refineEndpoints(px, channel, 1, indices, ALPHA_WEIGHTS_8, end0, end1)) break;
+		int a0 = roundChannel(end0[channel]), a1 = roundChannel(end1[channel]);
+		if (a0 <= a1) break;	// would flip into the six value mode
+
+		unsigned char candidate[8];
+		uint8_t candidateIndices[16];
+		float error = encodeAlphaEndpoints(px, channel, a0, a1, candidate, candidateIndices);
+		if (error >= best) break;
+		best = error;
+		std::memcpy(out, candidate, 8);
+		std::memcpy(indices, candidateIndices, 16);
+	}
+
+	// blocks mixing fully transparent or opaque pixels with a soft range fit the six value mode better
+	if (quality == COMPRESSION_HIGH && innerLow <= innerHigh && (low == 0.0f || high == 255.0f)) {
+		unsigned char candidate[8];
+		if (encodeAlphaEndpoints(px, channel, roundChannel(innerLow), roundChannel(innerHigh), candidate, indices) < best) {
+			std::memcpy(out, candidate, 8);
+		}
+	}
+}
+
+
+// BC7 mode 6: one subset, RGBA endpoints of 7 bits plus a p-bit each, 4 bit indices
+
+static const int BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+// 128 bit block written from the least significant bit up
+class BlockBits {
+public:
+	unsigned char* bytes;
+	int position = 0;
+
+	explicit BlockBits(unsigned char* block) : bytes(block) { std::memset(bytes, 0, 16); }
+
+	void put(uint32_t value, int count) {
+		for (int i = 0; i < count; i++, position++) {
+			if (value & (1u << i)) bytes[position >> 3] |= static_cast<unsigned char>(1u << (position & 7));
+		}
+	}
+};
+
+static uint32_t getBits(const unsigned char* bytes, int& position, int count) {
+	uint32_t value = 0;
+	for (int i = 0; i < count; i++, position++) {
+		if (bytes[position >> 3] & (1u << (position & 7))) value |= 1u << i;
+	}
+	return value;
+}
+
+// 7 bit value and p-bit closest to the endpoint
+static void quantizeBC7(const float end[4], int pbit, int quantized[4]) {
+	for (int c = 0; c < 4; c++) quantized[c] = std::min(std::max(static_cast<int>((end[c] - pbit) / 2.0f + 0.5f), 0), 127);
+}
+
+static int bestPBit(const float end[4]) {
+	float error[2] = {};
+	for (int pbit = 0; pbit < 2; pbit++) {
+		int quantized[4];
+		quantizeBC7(end, pbit, quantized);
+		for (int c = 0; c < 4; c++) error[pbit] += std::fabs(static_cast<float>((quantized[c] << 1) | pbit) - end[c]);
+	}
+	return error[1] < error[0] ? 1 : 0;
+}
+
+// the endpoints and p-bits are swapped in place when the anchor index needs it, so they stay in the
+// order the indices refer to
+static float encodeBC7Endpoints(const BlockPixels& px, float end0[4], float end1[4], int& p0, int& p1, unsigned char out[16], uint8_t indices[16]) {
+	int q0[4], q1[4];
+	quantizeBC7(end0, p0, q0);
+	quantizeBC7(end1, p1, q1);
+
+	int e0[4], e1[4];
+	for (int c = 0; c < 4; c++) {
+		e0[c] = (q0[c] << 1) | p0;
+		e1[c] = (q1[c] << 1) | p1;
+	}
+	float palette[16][4];
+	for (int p = 0; p < 16; p++) {
+		for (int c = 0; c < 4; c++) palette[p][c] = static_cast<float>(((64 - BC7_WEIGHTS[p]) * e0[c] + BC7_WEIGHTS[p] * e1[c] + 32) >> 6);
+	}
+	float error = fitIndices(px, 0, 4, palette, 16, indices);
+
+	// the first index is stored without its top bit, swapping the endpoints keeps it below 8
+	if (indices[0] & 8) {
+		std::swap(q0, q1);
+		std::swap(p0, p1);
+		for (int c = 0; c < 4; c++) std::swap(end0[c], end1[c]);
+		for (int i = 0; i < 16; i++) indices[i] = static_cast<uint8_t>(15 - indices[i]);
+	}
+
+	BlockBits bits(out);
+	bits.put(1u << 6, 7);	// mode 6
+	for (int c = 0; c < 4; c++) {
+		bits.put(q0[c], 7);
+		bits.put(q1[c], 7);
+	}
+	bits.put(p0, 1);
+	bits.put(p1, 1);
+	bits.put(indices[0], 3);
+	for (int i = 1; i < 16; i++) bits.put(indices[i], 4);
+	return error;
+}
+
+static void encodeBC7Block(const BlockPixels& px, CompressionQuality quality, unsigned char out[16]) {
+	float weights[16];
+	for (int i = 0; i < 16; i++) weights[i] = BC7_WEIGHTS[i] / 64.0f;
+
+	float end0[4], end1[4];
+	if (quality == COMPRESSION_FAST) boxEndpoints(px, 0, 4, end0, end1);
+	else axisEndpoints(px, 0, 4, end0, end1);
+
+	// refinements keep the p-bits they started with, HIGH starts from every pair
+	int pairs = quality == COMPRESSION_HIGH ? 4 : 1;
+	float best = 1e30f;
+	for (int pair = 0; pair < pairs; pair++) {
+		int p0 = pairs == 1 ? bestPBit(end0) : pair & 1;
+		int p1 = pairs == 1 ? bestPBit(end1) : pair >> 1;
+		float start0[4], start1[4];
+		std::memcpy(start0, end0, sizeof(start0));
+		std::memcpy(start1, end1, sizeof(start1));
+
+		unsigned char candidate[16];
+		uint8_t indices[16];
+		float error = encodeBC7Endpoints(px, start0, start1, p0, p1, candidate, indices);
+		if (error < best) {
+			best = error;
+			std::memcpy(out, candidate, 16);
+		}
+
+		for (int pass = 0; pass < refinementPasses(quality) && error > 0.0f; pass++) {
+			float refined0[4], refined1[4];
+			std::memcpy(refined0, start0, sizeof(refined0));
+			std::memcpy(refined1, start1, sizeof(refined1));
+			if (!refineEndpoints(px, 0, 4, indices, weights, refined0, refined1)) break;
+
+			int r0 = p0, r1 = p1;
+			uint8_t refinedIndices[16];
+			float refined = encodeBC7Endpoints(px, refined0, refined1, r0, r1, candidate, refinedIndices);
+			if (refined >= error) break;
+			error = refined;
+			std::memcpy(start0, refined0, sizeof(start0));
+			std::memcpy(start1, refined1, sizeof(start1));
+			std::memcpy(indices, refinedIndices, 16);
+			p0 = r0;
+			p1 = r1;
+			if (error < best) {
+				best = error;
+				std::memcpy(out, candidate, 16);
+			}
+		}
+	}
+}
+
+
+// decoders
+
+static void decodeColorBlock(const unsigned char in[8], bool forceFourColors, unsigned char block[64]) {
+	uint16_t c0 = static_cast<uint16_t>(in[0] | (in[1] << 8));
+	uint16_t c1 = static_cast<uint16_t>(in[2] | (in[3] << 8));
+	uint32_t indices = in[4] | (in[5] << 8) | (in[6] << 16) | (static_cast<uint32_t>(in[7]) << 24);
+
+	int palette[4][4];
+	colorPalette(c0, c1, forceFourColors || c0 > c1, palette);
+	for (int i = 0; i < 16; i++) {
+		const int* color = palette[(indices >> (i * 2)) & 3];
+		for (int c = 0; c < 4; c++) block[i * 4 + c] = static_cast<unsigned char>(color[c]);
+	}
+}
+
+static void decodeAlphaBlock(const unsigned char in[8], int channel, unsigned char block[64]) {
+	int palette[8];
+	alphaPalette(in[0], in[1], palette);
+
+	uint64_t indices = 0;
+	for (int b = 0; b < 6; b++) indices |= static_cast<uint64_t>(in[2 + b]) << (b * 8);
+	for (int i = 0; i < 16; i++) block[i * 4 + channel] = static_cast<unsigned char>(palette[(indices >> (i * 3)) & 7]);
+}
+
+// only mode 6 comes out of the encoder, other modes decode to transparent black
+static void decodeBC7Block(const unsigned char in[16], unsigned char block[64]) {
+	std::memset(block, 0, 64);
+	int position = 0;
+	if (getBits(in, position, 7) != (1u << 6)) return;
+
+	int e0[4], e1[4];
+	for (int c = 0; c < 4; c++) {
+		e0[c] = getBits(in, position, 7) << 1;
+		e1[c] = getBits(in, position, 7) << 1;
+	}
+	int p0 = getBits(in, position, 1), p1 = getBits(in, position, 1);
+	for (int c = 0; c < 4; c++) {
+		e0[c] |= p0;
+		e1[c] |= p1;
+	}
+
+	for (int i = 0; i < 16; i++) {
+		int weight = BC7_WEIGHTS[getBits(in, position, i == 0 ? 3 : 4)];
+		for (int c = 0; c < 4; c++) block[i * 4 + c] = static_cast<unsigned char>(((64 - weight) * e0[c] + weight * e1[c] + 32) >> 6);
+	}
+}
+
+
+void compressBlocks(BlockFormat format, const unsigned char* rgba, int width, int height, unsigned char* blocks, CompressionQuality quality) {
+	int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+	size_t stride = blockBytes(format);
+
+	ThreadPool::shared().parallelFor(blocksY, [&](size_t by) {
+		BlockPixels px;
+		for (int bx = 0; bx < blocksX; bx++) {
+			unsigned char* out = blocks + (by * blocksX + bx) * stride;
+			loadBlock(rgba, width, height, bx, static_cast<int>(by), px);
+
+			switch (format) {
+			case BLOCK_FORMAT_BC1:
+				encodeColorBlock(px, quality, true, out);
+				break;
+			case BLOCK_FORMAT_BC3:
+				encodeAlphaBlock(px, 3, quality, out);
+				encodeColorBlock(px, quality, false, out + 8);
+				break;
+			case BLOCK_FORMAT_BC5:
+				encodeAlphaBlock(px, 0, quality, out);
+				encodeAlphaBlock(px, 1, quality, out + 8);
+				break;
+			case BLOCK_FORMAT_BC7:
+				encodeBC7Block(px, quality, out);
+				break;
+			default:
+				break;
+			}
+		}
+	});
+}
+
+void decompressBlocks(BlockFormat format, const unsigned char* blocks, int width, int height, unsigned char* rgba) {
+	int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+	size_t stride = blockBytes(format);
+
+	unsigned char block[64];
+	for (int by = 0; by < blocksY; by++) {
+		for (int bx = 0; bx < blocksX; bx++) {
+			const unsigned char* in = blocks + (static_cast<size_t>(by) * blocksX + bx) * stride;
+
+			switch (format) {
+			case BLOCK_FORMAT_BC1:
+				// an RGB format, the transparent entry of the three color mode reads as black
+				decodeColorBlock(in, false, block);
+				for (int i = 0; i < 16; i++) block[i * 4 + 3] = 255;
+				break;
+			case BLOCK_FORMAT_BC3:
+				decodeColorBlock(in + 8, true, block);
+				decodeAlphaBlock(in, 3, block);
+				break;
+			case BLOCK_FORMAT_BC5:
+				for (int i = 0; i < 16; i++) {
+					block[i * 4 + 2] = 0;
+					block[i * 4 + 3] = 255;
+				}
+				decodeAlphaBlock(in, 0, block);
+				decodeAlphaBlock(in + 8, 1, block);
+				break;
+			case BLOCK_FORMAT_BC7:
+				decodeBC7Block(in, block);
+				break;
+			default:
+				std::memset(block, 0, 64);
+				break;
+			}
+			storeBlock(block, width, height, bx, by, rgba);
+		}
+	}
+}
@@ -0,0 +1,71 @@
+#ifndef BLOCK_COMPRESS_H
+#define BLOCK_COMPRESS_H
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// S3TC and BPTC formats aren't in core 3.3, the bundled glad header doesn't know them
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+
+// how a texture's pixels are stored, values are written to packages and caches
+enum BlockFormat : uint32_t {
+	BLOCK_FORMAT_NONE = 0,	// plain RGBA8
+	BLOCK_FORMAT_BC1 = 1,	// RGB, 8 bytes per 4x4 block
+	BLOCK_FORMAT_BC3 = 3,	// RGBA, BC1 color plus an interpolated alpha block, 16 bytes
+	BLOCK_FORMAT_BC5 = 5,	// RG in two alpha style blocks, 16 bytes. Normal maps, the shader rebuilds z from x and y
+	BLOCK_FORMAT_BC7 = 7,	// RGBA, 16 bytes. Only mode 6 is written and decoded, one subset with 4 bit indices
+};
+
+// encoder presets: how hard the endpoints are searched, FAST is a few times quicker than HIGH
+enum CompressionQuality : uint32_t {
+	COMPRESSION_FAST = 0,	// bounding box endpoints
+	COMPRESSION_NORMAL = 1,	// principal axis endpoints refined once by least squares
+	COMPRESSION_HIGH = 2,	// several refinements, BC1 also tries its three color mode, BC7 every p-bit pair
+};
+
+size_t blockBytes(BlockFormat format);
+size_t compressedSize(BlockFormat format, int width, int height);
+GLenum blockInternalFormat(BlockFormat format);
+bool validBlockFormat(uint32_t format);
+
+// normal maps go to BC5, textures with alpha to BC3 and the rest to BC1, or BC7 at high quality when allowed
+BlockFormat chooseBlockFormat(bool normalMap, bool hasAlpha, CompressionQuality quality, bool allowBC7);
+
+// encode tightly packed RGBA8 pixels into blocks, partial blocks at the edges repeat their last row and column.
+// Rows of blocks are spread over the shared worker pool
+void compressBlocks(BlockFormat format, const unsigned char* rgba, int width, int height, unsigned char* blocks,
+	CompressionQuality quality = COMPRESSION_NORMAL);
+
+// back to RGBA8, for drivers without the format
+void decompressBlocks(BlockFormat format, const unsigned char* blocks, int width, int height, unsigned char* rgba);
+
+// one level of a compressed chain, offset into CompressedImage::pixels
+struct CompressedMip {
+	uint64_t offset;
+	uint64_t bytes;
+	uint32_t width;
+	uint32_t height;
+};
+
+// a whole mip chain in one format
+struct CompressedImage {
+	BlockFormat format = BLOCK_FORMAT_NONE;
+	std::vector<CompressedMip> mips;
+	std::vector<unsigned char> pixels;
+
+	// RGBA8 size of the same chain, what compression saved is measured against it
+	size_t uncompressedBytes() const;
+};
+
+#endif
@@ -0,0 +1,340 @@
+#include "bvh.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <numeric>
+
+// deeper nodes become leaves whatever their size, keeps the fixed traversal stacks safe
+#define BVH_MAX_DEPTH 60
+#define BVH_STACK_SIZE 64
+
+struct Bvh::BuildContext {
+	std::vector<glm::vec3> centroids;
+	std::atomic<uint32_t> nodeCount;
+};
+
+// half the surface area, only ever compared
+static float boxArea(const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+	glm::vec3 size = glm::max(boundsMax - boundsMin, glm::vec3(0.0f));
+	return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+// distance where the ray enters the box, FLT_MAX when it misses it or only gets there after maxDistance
+static float rayBoxDistance(const glm::vec3& origin, const glm::vec3& inverseDirection, const glm::vec3& boundsMin, const glm::vec3& boundsMax, float maxDistance) {
+	glm::vec3 t0 = (boundsMin - origin) * inverseDirection;
+	glm::vec3 t1 = (boundsMax - origin) * inverseDirection;
+	glm::vec3 tNear = glm::min(t0, t1);
+	glm::vec3 tFar = glm::max(t0, t1);
+
+	float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+	float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+	return enter <= exit ? enter : FLT_MAX;
+}
+
+void Bvh::clear() {
+	nodes.clear();
+	items.clear();
+	parents.clear();
+	objectLeaf.clear();
+	objectMin.clear();
+	objectMax.clear();
+	dirtyLeaves.clear();
+}
+
+void Bvh::build(const glm::vec3* boundsMin, const glm::vec3* boundsMax, size_t count) {
+	clear();
+	if (count == 0) return;
+
+	objectMin.assign(boundsMin, boundsMin + count);
+	objectMax.assign(boundsMax, boundsMax + count);
+	items.resize(count);
+	std::iota(items.begin(), items.end(), 0u);
+
+	BuildContext context;
+	context.centroids.resize(count);
+	for (size_t i = 0; i < count; i++) context.centroids[i] = (boundsMin[i] + boundsMax[i]) * 0.5f;
+
+	// a binary tree over count leaves has at most 2 * count - 1 nodes, sizing up front lets
+	// the subtrees built on other threads claim nodes without locking
+	nodes.resize(2 * count - 1);
+	parents.resize(2 * count - 1);
+	parents[0] = BVH_NONE;
+	context.nodeCount = 1;
+
+	buildNode(context, 0, 0, static_cast<uint32_t>(count));
+
+	nodes.resize(context.nodeCount);
+	parents.resize(context.nodeCount);
+
+	objectLeaf.assign(count, BVH_NONE);
+	for (uint32_t node = 0; node < nodes.size(); node++) {
+		for (uint32_t i = 0; i < nodes[node].count; i++) objectLeaf[items[nodes[node].first + i]] = node;
+	}
+}
+
+void Bvh::buildNode(BuildContext& context, uint32_t node, uint32_t begin, uint32_t end) {
+	// depth is only needed for the cap, count it through the parents
+	unsigned int depth = 0;
+	for (uint32_t up = parents[node]; up != BVH_NONE && depth < BVH_MAX_DEPTH; up = parents[up]) depth++;
+
+	glm::vec3 boundsMin = objectMin[items[begin]], boundsMax = objectMax[items[begin]];
+	glm::vec3 centroidMin = context.centroids[items[begin]], centroidMax = centroidMin;
+	for (uint32_t i = begin + 1; i < end; i++) {
+		uint32_t object = items[i];
+		boundsMin = glm::min(boundsMin, objectMin[object]);
+		boundsMax = glm::max(boundsMax, objectMax[object]);
+		centroidMin = glm::min(centroidMin, context.centroids[object]);
+		centroidMax = glm::max(centroidMax, context.centroids[object]);
+	}
+
+	BvhNode& current = nodes[node];
+	current.boundsMin = boundsMin;
+	current.boundsMax = boundsMax;
+	current.first = begin;
+	current.count = end - begin;
+
+	uint32_t count = end - begin;
+	if (count == 1 || depth >= BVH_MAX_DEPTH) return;
+
+	// bin the centroids along every axis and sweep for the cheapest split
+	float area = boxArea(boundsMin, boundsMax);
+	float bestCost = FLT_MAX;
+	int bestAxis = -1, bestSplit = 0;
+	for (int axis = 0; axis < 3; axis++) {
+		float extent = centroidMax[axis] - centroidMin[axis];
+		if (extent <= 0.0f) continue;
+
+		uint32_t binCount[BVH_BINS] = {};
+		glm::vec3 binMin[BVH_BINS], binMax[BVH_BINS];
+		float binScale = BVH_BINS / extent;
+		for (uint32_t i = begin; i < end; i++) {
+			uint32_t object = items[i];
+			int bin = std::min(BVH_BINS - 1, static_cast<int>((context.centroids[object][axis] - centroidMin[axis]) * binScale));
+			binMin[bin] = binCount[bin] ? glm::min(binMin[bin], objectMin[object]) : objectMin[object];
+			binMax[bin] = binCount[bin] ? glm::max(binMax[bin], objectMax[object]) : objectMax[object];
+			binCount[bin]++;
+		}
+
+		// cost of the bins left of each split, then swept from the right
+		float leftCost[BVH_BINS - 1];
+		uint32_t leftCount = 0;
+		glm::vec3 leftMin(FLT_MAX), leftMax(-FLT_MAX);
+		for (int split = 0; split < BVH_BINS - 1; split++) {
+			if (binCount[split]) {
+				leftMin = glm::min(leftMin, binMin[split]);
+				leftMax = glm::max(leftMax, binMax[split]);
+				leftCount += binCount[split];
+			}
+			leftCost[split] = leftCount ? leftCount * boxArea(leftMin, leftMax) : 0.0f;
+		}
+
+		uint32_t rightCount = 0;
+		glm::vec3 rightMin(FLT_MAX), rightMax(-FLT_MAX);
+		for (int split = BVH_BINS - 2; split >= 0; split--) {
+			int bin = split + 1;
+			if (binCount[bin]) {
+				rightMin = glm::min(rightMin, binMin[bin]);
+				rightMax = glm::max(rightMax, binMax[bin]);
+				rightCount += binCount[bin];
+			}
+			if (rightCount == 0 || rightCount == count) continue;
+
+			float cost = leftCost[split] + rightCount * boxArea(rightMin, rightMax);
+			if (cost < bestCost) {
+				bestCost = cost;
+				bestAxis = axis;
+				bestSplit = split;
+			}
+		}
+	}
+
+	// traversing a node costs about as much as testing one object
+	bool splitPays = bestAxis >= 0 && area + bestCost < count * area;
+	if (!splitPays && count <= BVH_MAX_LEAF_SIZE) return;
+
+	uint32_t middle;
+	if (bestAxis >= 0) {
+		float binScale = BVH_BINS / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+		const glm::vec3* centroids = context.centroids.data();
+		float axisMin = centroidMin[bestAxis];
+		int axis = bestAxis, split = bestSplit;
+		middle = static_cast<uint32_t>(std::partition(items.begin() + begin, items.begin() + end, [=](uint32_t object) {
+			return std::min(BVH_BINS - 1, static_cast<int>((centroids[object][axis] - axisMin) * binScale)) <= split;
+		}) - items.begin());
+	}
+	else middle = begin + count / 2;	// every centroid in the same spot, any halves will do
+
+	uint32_t left = context.nodeCount.fetch_add(2);
+	current.first = left;
+	current.count = 0;
+	parents[left] = node;
+	parents[left + 1] = node;
+
+	if (count > BVH_PARALLEL_SIZE) {
+		ThreadPool::shared().parallelFor(2, [&](size_t child) {
+			if (child == 0) buildNode(context, left, begin, middle);
+			else buildNode(context, left + 1, middle, end);
+		});
+	}
+	else {
+		buildNode(context, left, begin, middle);
+		buildNode(context, left + 1, middle, end);
+	}
+}
+
+void Bvh::update(uint32_t object, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+	objectMin[object] = boundsMin;
+	objectMax[object] = boundsMax;
+	dirtyLeaves.push_back(objectLeaf[object]);
+}
+
+void Bvh::leafBounds(uint32_t node) {
+	BvhNode& leaf = nodes[node];
+	leaf.boundsMin = objectMin[items[leaf.first]];
+	leaf.boundsMax = objectMax[items[leaf.first]];
+	for (uint32_t i = 1; i < leaf.count; i++) {
+		leaf.boundsMin = glm::min(leaf.boundsMin, objectMin[items[leaf.first + i]]);
+		leaf.boundsMax = glm::max(leaf.boundsMax, objectMax[items[leaf.first + i]]);
+	}
+}
+
+void Bvh::refit() {
+	std::sort(dirtyLeaves.begin(), dirtyLeaves.end());
+	dirtyLeaves.erase(std::unique(dirtyLeaves.begin(), dirtyLeaves.end()), dirtyLeaves.end());
+
+	for (uint32_t leaf : dirtyLeaves) {
+		leafBounds(leaf);
+
+		// the walk up stops at the first node the change doesn't reach
+		for (uint32_t node = parents[leaf]; node != BVH_NONE; node = parents[node]) {
+			const BvhNode& left = nodes[nodes[node].first];
+			const BvhNode& right = nodes[nodes[node].first + 1];
+			glm::vec3 boundsMin = glm::min(left.boundsMin, right.boundsMin);
+			glm::vec3 boundsMax = glm::max(left.boundsMax, right.boundsMax);
+			if (boundsMin == nodes[node].boundsMin && boundsMax == nodes[node].boundsMax) break;
+
+			nodes[node].boundsMin = boundsMin;
+			nodes[node].boundsMax = boundsMax;
+		}
+	}
+	dirtyLeaves.clear();
+}
+
+void Bvh::cull(const Frustum& frustum, std::vector<uint32_t>& visible) const {
+	if (nodes.empty()) return;
+
+	uint32_t stack[BVH_STACK_SIZE];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		const BvhNode& node = nodes[stack[--top]];
+
+		FrustumOverlap overlap = boxInFrustum(frustum, node.boundsMin, node.boundsMax);
+		if (overlap == FRUSTUM_OUTSIDE) continue;
+
+		if (overlap == FRUSTUM_INSIDE) {
+			// a subtree's objects sit next to each other in items, from its leftmost to its rightmost leaf
+			const BvhNode* first = &node;
+			while (first->count == 0) first = &nodes[first->first];
+			const BvhNode* last = &node;
+			while (last->count == 0) last = &nodes[last->first + 1];
+			visible.insert(visible.end(), items.begin() + first->first, items.begin() + last->first + last->count);
+			continue;
+		}
+
+		if (node.count > 0) {
+			for (uint32_t i = 0; i < node.count; i++) {
+				uint32_t object = items[node.first + i];
+				if (boxInFrustum(frustum, objectMin[object], objectMax[object]) != FRUSTUM_OUTSIDE) visible.push_back(object);
+			}
+			continue;
+		}
+
+		stack[top++] = node.first;
+		stack[top++] = node.first + 1;
+	}
+}
+
+bool Bvh::raycast(const glm::vec3& origin, const glm::vec3& direction, BvhHit& hit, float maxDistance) const {
+	hit = BvhHit();
+	if (nodes.empty()) return false;
+
+	// divisions by zero give infinities, which the slab test handles
+	glm::vec3 inverseDirection = 1.0f / direction;
+	float best = maxDistance;
+
+	uint32_t stack[BVH_STACK_SIZE];
+	float stackDistance[BVH_STACK_SIZE];
+	int top = 0;
+	float rootDistance = rayBoxDistance(origin, inverseDirection, nodes[0].boundsMin, nodes[0].boundsMax, best);
+	if (rootDistance == FLT_MAX) return false;
+	stack[top] = 0;
+	stackDistance[top++] = rootDistance;
+
+	while (top > 0) {
+		top--;
+		if (stackDistance[top] > best) continue;	// something closer was found meanwhile
+		const BvhNode& node = nodes[stack[top]];
+
+		if (node.count > 0) {
+			for (uint32_t i = 0; i < node.count; i++) {
+				uint32_t object = items[node.first + i];
+				float distance = rayBoxDistance(origin, inverseDirection, objectMin[object], objectMax[object], best);
+				// distances never pass best, the first hit may land exactly on maxDistance
+				if (distance != FLT_MAX && (distance < best || hit.object == BVH_NONE)) {
+					best = distance;
+					hit.object = object;
+					hit.distance = distance;
+				}
+			}
+			continue;
+		}
+
+		// the nearer child goes on top so it is visited first and prunes the other one
+		uint32_t nearChild = node.first, farChild = node.first + 1;
+		float nearDistance = rayBoxDistance(origin, inverseDirection, nodes[nearChild].boundsMin, nodes[nearChild].boundsMax, best);
+		float farDistance = rayBoxDistance(origin, inverseDirection, nodes[farChild].boundsMin, nodes[farChild].boundsMax, best);
+		if (farDistance < nearDistance) {
+			std::swap(nearChild, farChild);
+			std::swap(nearDistance, farDistance);
+		}
+		if (farDistance != FLT_MAX) {
+			stack[top] = farChild;
+			stackDistance[top++] = farDistance;
+		}
+		if (nearDistance != FLT_MAX) {
+			stack[top] = nearChild;
+			stackDistance[top++] = nearDistance;
+		}
+	}
+	return hit.object != BVH_NONE;
+}
+
+float Bvh::sahCost() const {
+	if (nodes.empty()) return 0.0f;
+
+	float cost = 0.0f;
+	for (const BvhNode& node : nodes) {
+		float area = boxArea(node.boundsMin, node.boundsMax);
+		cost += node.count > 0 ? area * node.count : area;
+	}
+	float rootArea = boxArea(nodes[0].boundsMin, nodes[0].boundsMax);
+	return rootArea > 0.0f ? cost / rootArea : cost;
+}
+
+void transformBounds(const glm::mat4& transform, const glm::vec3& boundsMin, const glm::vec3& boundsMax, glm::vec3& outMin, glm::vec3& outMax) {
+	// center moves with the matrix, the half extent through its absolute value
+	glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+	glm::vec3 extent = (boundsMax - boundsMin) * 0.5f;
+
+	glm::vec3 newCenter = glm::vec3(transform * glm::vec4(center, 1.0f));
+	glm::vec3 newExtent(0.0f);
+	for (int column = 0; column < 3; column++) {
+		for (int row = 0; row < 3; row++) newExtent[row] += std::fabs(transform[column][row]) * extent[column];
+	}
+
+	outMin = newCenter - newExtent;
+	outMax = newCenter + newExtent;
+}
@@ -0,0 +1,76 @@
+#ifndef BVH_H
+#define BVH_H
+
+#include "frustum.h"
+
+#include <glm/glm/glm.hpp>
+
+#include <cfloat>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define BVH_BINS 16					// SAH candidates per axis
+#define BVH_MAX_LEAF_SIZE 8			// bigger leaves are always split, even when SAH would keep them
+#define BVH_PARALLEL_SIZE 4096		// subtrees with more objects build their children on the pool
+#define BVH_NONE 0xffffffffu
+
+// 32 bytes. Leaves have a count and index items[first, first + count), inner nodes have
+// a count of 0 and their children at first and first + 1
+struct BvhNode {
+	glm::vec3 boundsMin;
+	uint32_t first;
+	glm::vec3 boundsMax;
+	uint32_t count;
+};
+
+struct BvhHit {
+	uint32_t object = BVH_NONE;
+	float distance = FLT_MAX;	// along the ray to where it enters the object's box
+};
+
+// Bounding volume hierarchy over the boxes of scene objects, built with binned SAH. Moving
+// objects are refit in place instead of rebuilt. Objects are referred to by their index in
+// the arrays given to build()
+class Bvh {
+public:
+	void build(const glm::vec3* boundsMin, const glm::vec3* boundsMax, size_t count);
+	void clear();
+
+	// new box of a moved object, the tree follows on the next refit()
+	void update(uint32_t object, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+	// grow or shrink the nodes above every updated object, only their paths are touched
+	void refit();
+
+	// append the objects whose box touches the frustum, whole subtrees inside it are taken without tests
+	void cull(const Frustum& frustum, std::vector<uint32_t>& visible) const;
+
+	// closest object box the ray enters before maxDistance, direction doesn't have to be normalized
+	bool raycast(const glm::vec3& origin, const glm::vec3& direction, BvhHit& hit, float maxDistance = FLT_MAX) const;
+
+	size_t objectCount() const { return objectMin.size(); }
+	size_t nodeCount() const { return nodes.size(); }
+	bool empty() const { return nodes.empty(); }
+	const BvhNode& root() const { return nodes[0]; }
+
+	// expected traversal cost relative to the root, refits make it grow until the next build
+	float sahCost() const;
+
+private:
+	struct BuildContext;
+
+	std::vector<BvhNode> nodes;
+	std::vector<uint32_t> items;		// object indices, grouped by leaf
+	std::vector<uint32_t> parents;		// per node, BVH_NONE for the root
+	std::vector<uint32_t> objectLeaf;	// per object
+	std::vector<glm::vec3> objectMin, objectMax;
+	std::vector<uint32_t> dirtyLeaves;
+
+	void buildNode(BuildContext& context, uint32_t node, uint32_t begin, uint32_t end);
+	void leafBounds(uint32_t node);
+};
+
+// box around a transformed box
+void transformBounds(const glm::mat4& transform, const glm::vec3& boundsMin, const glm::vec3& boundsMax, glm::vec3& outMin, glm::vec3& outMax);
+
+#endif
@@ -0,0 +1,121 @@
+#include "frustum.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_SSE
+#endif
+
+Frustum frustumFromMatrix(const glm::mat4& viewProjection) {
+	// rows of the matrix, glm stores columns
+	glm::vec4 rows[4];
+	for (int i = 0; i < 4; i++) rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+
+	Frustum frustum;
+	frustum.planes[0] = rows[3] + rows[0];
+	frustum.planes[1] = rows[3] - rows[0];
+	frustum.planes[2] = rows[3] + rows[1];
+	frustum.planes[3] = rows[3] - rows[1];
+	frustum.planes[4] = rows[3] + rows[2];
+	frustum.planes[5] = rows[3] - rows[2];
+
+	// unit normals so the plane equation gives real distances to compare radii with
+	for (glm::vec4& plane : frustum.planes) {
+		float length = glm::length(glm::vec3(plane));
+		if (length > 0.0f) plane = plane * (1.0f / length);
+	}
+	return frustum;
+}
+
+bool sphereInFrustum(const Frustum& frustum, const glm::vec3& center, float radius) {
+	for (const glm::vec4& plane : frustum.planes) {
+		if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) return false;
+	}
+	return true;
+}
+
+FrustumOverlap boxInFrustum(const Frustum& frustum, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+	FrustumOverlap overlap = FRUSTUM_INSIDE;
+	for (const glm::vec4& plane : frustum.planes) {
+		// the corners farthest along and against the plane normal
+		glm::vec3 positive, negative;
+		for (int axis = 0; axis < 3; axis++) {
+			positive[axis] = plane[axis] >= 0.0f ? boundsMax[axis] : boundsMin[axis];
+			negative[axis] = plane[axis] >= 0.0f ? boundsMin[axis] : boundsMax[axis];
+		}
+		if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f) return FRUSTUM_OUTSIDE;
+		if (glm::dot(glm::vec3(plane), negative) + plane.w < 0.0f) overlap = FRUSTUM_INTERSECTS;
+	}
+	return overlap;
+}
+
+void BoundingSpheres::clear() {
+	x.clear();
+	y.clear();
+	z.clear();
+	radius.clear();
+	count = 0;
+}
+
+void BoundingSpheres::push_back(const glm::vec3& center, float sphereRadius) {
+	// fill the padding slot if there is one, otherwise open a new group of four
+	if (count == x.size()) {
+		x.resize(count + 4, 0.0f);
+		y.resize(count + 4, 0.0f);
+		z.resize(count + 4, 0.0f);
+		radius.resize(count + 4, 0.0f);
+	}
+	x[count] = center.x;
+	y[count] = center.y;
+	z[count] = center.z;
+	radius[count] = sphereRadius;
+	count++;
+}
+
+void cullSpheres(const Frustum& frustum, const glm::mat4& model, const BoundingSpheres& spheres, uint8_t* visible) {
+	float scale = std::max(glm::length(glm::vec3(model[0])), std::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+	size_t count = spheres.size();
+
+#ifdef FRUSTUM_SSE
+	__m128 m[4][3];
+	for (int column = 0; column < 4; column++) {
+		for (int row = 0; row < 3; row++) m[column][row] = _mm_set1_ps(model[column][row]);
+	}
+	__m128 planes[6][4];
+	for (int p = 0; p < 6; p++) {
+		for (int i = 0; i < 4; i++) planes[p][i] = _mm_set1_ps(frustum.planes[p][i]);
+	}
+	__m128 negScale = _mm_set1_ps(-scale);
+
+	for (size_t i = 0; i < count; i += 4) {
+		__m128 x = _mm_loadu_ps(&spheres.x[i]);
+		__m128 y = _mm_loadu_ps(&spheres.y[i]);
+		__m128 z = _mm_loadu_ps(&spheres.z[i]);
+		__m128 minDistance = _mm_mul_ps(_mm_loadu_ps(&spheres.radius[i]), negScale);
+
+		// centers to world space
+		__m128 world[3];
+		for (int row = 0; row < 3; row++) {
+			world[row] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0][row], x), _mm_mul_ps(m[1][row], y)), _mm_add_ps(_mm_mul_ps(m[2][row], z), m[3][row]));
+		}
+
+		__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (int p = 0; p < 6; p++) {
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planes[p][0], world[0]), _mm_mul_ps(planes[p][1], world[1])),
+				_mm_add_ps(_mm_mul_ps(planes[p][2], world[2]), planes[p][3]));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, minDistance));
+		}
+
+		int mask = _mm_movemask_ps(inside);
+		size_t lanes = std::min<size_t>(4, count - i);
+		for (size_t lane = 0; lane < lanes; lane++) visible[i + lane] = (mask >> lane) & 1;
+	}
+#else
+	for (size_t i = 0; i < count; i++) {
+		glm::vec3 center = glm::vec3(model * glm::vec4(spheres.x[i], spheres.y[i], spheres.z[i], 1.0f));
+		visible[i] = sphereInFrustum(frustum, center, spheres.radius[i] * scale) ? 1 : 0;
+	}
+#endif
+}
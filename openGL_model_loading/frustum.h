@@ -0,0 +1,47 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <glm/glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// the six planes of a view volume, xyz is the unit normal pointing inside and w the distance
+struct Frustum {
+	glm::vec4 planes[6];	// left, right, bottom, top, near, far
+};
+
+// world space frustum of projection * view
+Frustum frustumFromMatrix(const glm::mat4& viewProjection);
+
+// false when the sphere lies completely outside one of the planes
+bool sphereInFrustum(const Frustum& frustum, const glm::vec3& center, float radius);
+
+enum FrustumOverlap {
+	FRUSTUM_OUTSIDE,
+	FRUSTUM_INTERSECTS,
+	FRUSTUM_INSIDE
+};
+
+// where an axis aligned box lies, INTERSECTS is conservative near the corners of the frustum
+FrustumOverlap boxInFrustum(const Frustum& frustum, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+
+// object space spheres laid out one component per array so four of them are tested at once.
+// The arrays are padded to a multiple of 4, size() is the real count
+struct BoundingSpheres {
+	std::vector<float> x, y, z, radius;
+
+	size_t size() const { return count; }
+	void clear();
+	void push_back(const glm::vec3& center, float sphereRadius);
+
+private:
+	size_t count = 0;
+};
+
+// move the spheres by model and test them against the frustum, four per step with SSE when the
+// target has it. visible[i] is 1 when sphere i touches the frustum, radii grow with the largest axis scale
+void cullSpheres(const Frustum& frustum, const glm::mat4& model, const BoundingSpheres& spheres, uint8_t* visible);
+
+#endif
@@ -0,0 +1,35 @@
+#include "gl_extensions.h"
+
+#include <GLFW/glfw3.h>
+
+#include <cstring>
+
+bool hasGLExtension(const char* name) {
+	GLint count = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+	for (GLint i = 0; i < count; i++) {
+		const char* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+		if (extension && std::strcmp(extension, name) == 0) return true;
+	}
+	return false;
+}
+
+static GLExtensions queryExtensions() {
+	GLExtensions extensions;
+
+	bool gl43 = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 3);
+	if (gl43 || hasGLExtension("GL_ARB_multi_draw_indirect")) {
+		extensions.multiDrawElementsIndirect = (MultiDrawElementsIndirectProc)glfwGetProcAddress("glMultiDrawElementsIndirect");
+		extensions.multiDrawIndirect = extensions.multiDrawElementsIndirect != nullptr;
+	}
+	extensions.textureCompressionS3TC = hasGLExtension("GL_EXT_texture_compression_s3tc");
+
+	bool gl42 = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 2);
+	extensions.textureCompressionBPTC = gl42 || hasGLExtension("GL_ARB_texture_compression_bptc");
+	return extensions;
+}
+
+const GLExtensions& glExtensions() {
+	static GLExtensions extensions = queryExtensions();
+	return extensions;
+}
@@ -0,0 +1,26 @@
+#ifndef GL_EXTENSIONS_H
+#define GL_EXTENSIONS_H
+
+#include <glad/glad.h>
+
+// The bundled glad loader only covers core 3.3, entry points of newer versions and
+// extensions are fetched here when the driver has them
+#ifndef GL_DRAW_INDIRECT_BUFFER
+#define GL_DRAW_INDIRECT_BUFFER 0x8F3F
+#endif
+
+typedef void (APIENTRYP MultiDrawElementsIndirectProc)(GLenum mode, GLenum type, const void* indirect, GLsizei drawcount, GLsizei stride);
+
+struct GLExtensions {
+	bool multiDrawIndirect = false;		// GL 4.3 or ARB_multi_draw_indirect
+	MultiDrawElementsIndirectProc multiDrawElementsIndirect = nullptr;
+	bool textureCompressionS3TC = false;	// EXT_texture_compression_s3tc, BC1 to BC3 uploads
+	bool textureCompressionBPTC = false;	// GL 4.2 or ARB_texture_compression_bptc, BC7 uploads
+};
+
+// queried once on first use, needs a current context
+const GLExtensions& glExtensions();
+
+bool hasGLExtension(const char* name);
+
+#endif
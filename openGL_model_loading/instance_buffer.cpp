@@ -0,0 +1,57 @@
+#include "instance_buffer.h"
+
+#include <algorithm>
+
+InstanceBuffer::~InstanceBuffer() {
+	if (buffer) glDeleteBuffers(1, &buffer);
+}
+
+InstanceBuffer::InstanceBuffer(InstanceBuffer&& other) noexcept
+	: buffer(other.buffer), instanceCount(other.instanceCount), instanceCapacity(other.instanceCapacity) {
+	other.buffer = 0;
+	other.instanceCount = 0;
+	other.instanceCapacity = 0;
+}
+
+InstanceBuffer& InstanceBuffer::operator=(InstanceBuffer&& other) noexcept {
+	if (this != &other) {
+		if (buffer) glDeleteBuffers(1, &buffer);
+		buffer = other.buffer;
+		instanceCount = other.instanceCount;
+		instanceCapacity = other.instanceCapacity;
+		other.buffer = 0;
+		other.instanceCount = 0;
+		other.instanceCapacity = 0;
+	}
+	return *this;
+}
+
+void InstanceBuffer::upload(const glm::mat4* transforms, size_t count) {
+	// the name never changes, so VAOs attached earlier stay valid when the storage grows
+	if (!buffer) glGenBuffers(1, &buffer);
+	glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+	if (count > instanceCapacity) instanceCapacity = std::max(count, instanceCapacity * 2);
+
+	// same size as before unless it grew, orphaning the old storage keeps the driver from waiting on last frame's draws
+	glBufferData(GL_ARRAY_BUFFER, instanceCapacity * sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+	if (count > 0) glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(glm::mat4), transforms);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	instanceCount = count;
+}
+
+void InstanceBuffer::attach(unsigned int VAO) const {
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+	// a mat4 attribute is four vec4 columns, advanced once per instance
+	for (int column = 0; column < 4; column++) {
+		glEnableVertexAttribArray(INSTANCE_ATTRIBUTE + column);
+		glVertexAttribPointer(INSTANCE_ATTRIBUTE + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(column * sizeof(glm::vec4)));
+		glVertexAttribDivisor(INSTANCE_ATTRIBUTE + column, 1);
+	}
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
@@ -0,0 +1,42 @@
+#ifndef INSTANCE_BUFFER_H
+#define INSTANCE_BUFFER_H
+
+#include <glad/glad.h>
+
+#include <glm/glm/glm.hpp>
+
+#include <cstddef>
+
+// first of the four attribute locations the per instance model matrix takes in model_vShader.vert
+#define INSTANCE_ATTRIBUTE 7
+
+// Per instance model matrices for glDrawElementsInstanced. The GL buffer is kept between
+// frames and only reallocated when more instances than ever before are uploaded. GL thread only
+class InstanceBuffer {
+public:
+	InstanceBuffer() {}
+	~InstanceBuffer();
+
+	InstanceBuffer(const InstanceBuffer&) = delete;
+	InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+	InstanceBuffer(InstanceBuffer&& other) noexcept;
+	InstanceBuffer& operator=(InstanceBuffer&& other) noexcept;
+
+	// replace the contents with this frame's transforms
+	void upload(const glm::mat4* transforms, size_t count);
+
+	// point the instance attributes of a VAO at this buffer, the VAO keeps them
+	void attach(unsigned int VAO) const;
+
+	unsigned int id() const { return buffer; }
+	size_t count() const { return instanceCount; }
+	size_t capacity() const { return instanceCapacity; }
+
+private:
+	unsigned int buffer = 0;
+	size_t instanceCount = 0;
+	size_t instanceCapacity = 0;
+};
+
+#endif
@@ -0,0 +1,251 @@
+#include "material_arrays.h"
+#include "mesh_data.h"
+#include "texture_residency.h"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+// arrays bound per unit from MATERIAL_ARRAY_FIRST_UNIT on since the last build, only Mesh binds 2D arrays so this stays in sync
+static unsigned int boundArrays[MAX_MATERIAL_ARRAY_SLOTS] = {};
+
+// what a texture has to share with the other layers of an array
+struct TextureShape {
+	GLint width = 0;
+	GLint height = 0;
+	GLint levels = 0;
+	GLint compressedFormat = 0;	// 0 for plain textures, they are all copied as RGBA8
+	GLint wrap = GL_REPEAT;
+	GLint minFilter = GL_NEAREST;
+	GLint magFilter = GL_NEAREST;
+};
+
+static bool queryShape(unsigned int textureID, TextureShape& shape) {
+	glBindTexture(GL_TEXTURE_2D, textureID);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &shape.width);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &shape.height);
+	if (shape.width <= 0 || shape.height <= 0) return false;
+
+	GLint compressed = GL_FALSE;
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_COMPRESSED, &compressed);
+	if (compressed) glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &shape.compressedFormat);
+
+	// generated chains go down to 1x1, prebuilt ones may stop early and say so in their max level
+	GLint maxLevel = 1000;
+	glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, &maxLevel);
+	GLint fullChain = 1;
+	while ((std::max(shape.width, shape.height) >> fullChain) > 0) fullChain++;
+	shape.levels = std::min(fullChain, maxLevel + 1);
+
+	glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, &shape.wrap);
+	glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, &shape.minFilter);
+	glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, &shape.magFilter);
+	return true;
+}
+
+// the array takes the sampler state of its first texture, so wrap and filters have to match too
+static std::string shapeKey(TextureType type, const TextureShape& shape) {
+	return std::string(textureTypeName(type)) + ':' + std::to_string(shape.width) + 'x' + std::to_string(shape.height) + ':' + std::to_string(shape.levels) + ':' + std::to_string(shape.compressedFormat)
+		+ ':' + std::to_string(shape.wrap) + ':' + std::to_string(shape.minFilter) + ':' + std::to_string(shape.magFilter) + ';';
+}
+
+// storage for every level and layer, filled by copyLayer
+static unsigned int createArray(const TextureShape& shape, unsigned int firstTexture, unsigned int layers, size_t& bytes) {
+	unsigned int arrayID;
+	glGenTextures(1, &arrayID);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, arrayID);
+	glBindTexture(GL_TEXTURE_2D, firstTexture);
+
+	for (GLint level = 0; level < shape.levels; level++) {
+		GLsizei width = std::max(shape.width >> level, 1), height = std::max(shape.height >> level, 1);
+		if (shape.compressedFormat) {
+			GLint size = 0;
+			glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &size);
+			glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, level, shape.compressedFormat, width, height, layers, 0, size * layers, nullptr);
+			bytes += static_cast<size_t>(size) * layers;
+		}
+		else {
+			glTexImage3D(GL_TEXTURE_2D_ARRAY, level, GL_RGBA8, width, height, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			bytes += static_cast<size_t>(width) * height * 4 * layers;
+		}
+	}
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, shape.levels - 1);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, shape.wrap);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, shape.wrap);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, shape.minFilter);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, shape.magFilter);
+	return arrayID;
+}
+
+// core 3.3 can't copy between textures on the GPU, every level goes through a read back
+static void copyLayer(unsigned int arrayID, unsigned int textureID, const TextureShape& shape, GLint layer, std::vector<unsigned char>& scratch) {
+	glBindTexture(GL_TEXTURE_2D_ARRAY, arrayID);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+
+	for (GLint level = 0; level < shape.levels; level++) {
+		GLsizei width = std::max(shape.width >> level, 1), height = std::max(shape.height >> level, 1);
+		if (shape.compressedFormat) {
+			GLint size = 0;
+			glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &size);
+			scratch.resize(size);
+			glGetCompressedTexImage(GL_TEXTURE_2D, level, scratch.data());
+			glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, width, height, 1, shape.compressedFormat, size, scratch.data());
+		}
+		else {
+			scratch.resize(static_cast<size_t>(width) * height * 4);
+			glGetTexImage(GL_TEXTURE_2D, level, GL_RGBA, GL_UNSIGNED_BYTE, scratch.data());
+			glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, scratch.data());
+		}
+	}
+}
+
+MaterialArrays::~MaterialArrays() {
+	for (const MaterialArrayGroup& group : groups) {
+		for (unsigned int arrayID : group.arrays) TextureResidency::shared().forget(arrayID);
+		glDeleteTextures(static_cast<GLsizei>(group.arrays.size()), group.arrays.data());
+	}
+	// deleted names are unbound, and may come back for new textures
+	std::fill(boundArrays, boundArrays + MAX_MATERIAL_ARRAY_SLOTS, 0u);
+}
+
+void MaterialArrays::build(std::vector<Mesh>& meshes) {
+	if (!groups.empty()) return;	// meshes point into groups, it is built once
+
+	// a material is the list of textures a mesh binds
+	struct Material {
+		std::vector<unsigned int> textures;
+		std::vector<TextureType> types;
+		std::string key;
+		int group = -1;
+		unsigned int layer = 0;
+	};
+	std::vector<Material> materials;
+	std::map<std::vector<unsigned int>, size_t> materialByTextures;
+	std::vector<int> meshMaterial(meshes.size(), -1);
+	std::map<unsigned int, TextureShape> shapes;
+
+	for (size_t i = 0; i < meshes.size(); i++) {
+		const Mesh& mesh = meshes[i];
+		if (!mesh.isReady() || mesh.textures.empty() || mesh.textures.size() > MAX_MATERIAL_ARRAY_SLOTS) continue;
+
+		std::vector<unsigned int> textureIDs;
+		for (const Texture& texture : mesh.textures) textureIDs.push_back(texture.id);
+
+		auto found = materialByTextures.find(textureIDs);
+		if (found == materialByTextures.end()) {
+			Material material;
+			material.textures = textureIDs;
+			unsigned int numbers[TEXTURE_TYPE_COUNT] = {};
+			for (const Texture& texture : mesh.textures) {
+				// a sampler past the ones with a unit of their own would not be read
+				if (texture.type >= TEXTURE_TYPE_COUNT || materialArrayUnit(texture.type, ++numbers[texture.type]) < 0) {
+					material.key.clear();
+					break;
+				}
+
+				auto shape = shapes.find(texture.id);
+				if (shape == shapes.end()) {
+					// a texture missing its top levels would be copied in at the reduced size and never
+					// get them back, it stays a plain texture the residency manager can restore
+					TextureShape queried;
+					if (TextureResidency::shared().droppedLevels(texture.id) > 0 || !queryShape(texture.id, queried)) queried.width = 0;
+					shape = shapes.emplace(texture.id, queried).first;
+				}
+				// a texture that failed to load or is reduced keeps its material out of the arrays
+				if (shape->second.width == 0) {
+					material.key.clear();
+					break;
+				}
+				material.types.push_back(texture.type);
+				material.key += shapeKey(texture.type, shape->second);
+			}
+			found = materialByTextures.emplace(textureIDs, materials.size()).first;
+			materials.push_back(material);
+		}
+		meshMaterial[i] = static_cast<int>(found->second);
+	}
+
+	// materials of the same shape, at most as many per group as an array has layers
+	GLint maxLayers = 0;
+	glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+	if (maxLayers <= 0) maxLayers = 256;	// the minimum core 3.3 guarantees
+
+	std::map<std::string, std::vector<size_t>> materialsByShape;
+	for (size_t m = 0; m < materials.size(); m++) {
+		if (!materials[m].key.empty()) materialsByShape[materials[m].key].push_back(m);
+	}
+
+	std::vector<unsigned char> scratch;
+	for (const auto& shaped : materialsByShape) {
+		const std::vector<size_t>& members = shaped.second;
+		if (members.size() < 2) continue;	// nothing to save on a material of its own
+
+		for (size_t first = 0; first < members.size(); first += maxLayers) {
+			unsigned int layers = static_cast<unsigned int>(std::min(members.size() - first, static_cast<size_t>(maxLayers)));
+			const Material& leader = materials[members[first]];
+
+			MaterialArrayGroup group;
+			group.layers = layers;
+			unsigned int numbers[TEXTURE_TYPE_COUNT] = {};
+			for (size_t slot = 0; slot < leader.textures.size(); slot++) {
+				// texture_diffuse samples become material_diffuse, numbered per type like the plain samplers
+				TextureType type = leader.types[slot];
+				group.units.push_back(materialArrayUnit(type, ++numbers[type]));
+
+				const TextureShape& shape = shapes[leader.textures[slot]];
+				size_t arrayBytes = 0;
+				unsigned int arrayID = createArray(shape, leader.textures[slot], layers, arrayBytes);
+				for (unsigned int layer = 0; layer < layers; layer++) {
+					copyLayer(arrayID, materials[members[first + layer]].textures[slot], shape, static_cast<GLint>(layer), scratch);
+				}
+				group.arrays.push_back(arrayID);
+				counters.bytes += arrayBytes;
+
+				// arrays are not reduced, but they count against the budget so the plain textures make room
+				TextureResidency::shared().pin(arrayID, arrayBytes);
+			}
+
+			for (unsigned int layer = 0; layer < layers; layer++) {
+				materials[members[first + layer]].group = static_cast<int>(groups.size());
+				materials[members[first + layer]].layer = layer;
+			}
+			groups.push_back(group);
+			counters.materials += layers;
+		}
+	}
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+	glBindTexture(GL_TEXTURE_2D, 0);
+	counters.groups = static_cast<unsigned int>(groups.size());
+
+	// groups is complete, pointers into it stay valid from here on
+	for (size_t i = 0; i < meshes.size(); i++) {
+		if (meshMaterial[i] < 0) continue;
+		const Material& material = materials[meshMaterial[i]];
+		if (material.group < 0) {
+			counters.unpackedMeshes++;
+			continue;
+		}
+		meshes[i].materialGroup = &groups[material.group];
+		meshes[i].materialLayer = material.layer;
+		counters.packedMeshes++;
+	}
+}
+
+void MaterialArrays::printStats() const {
+	std::cout << "MATERIAL_ARRAYS:: " << counters.materials << " materials in " << counters.groups << " groups, " << counters.bytes / 1024 << " KB, meshes packed "
+		<< counters.packedMeshes << ", left on plain textures " << counters.unpackedMeshes << std::endl;
+}
+
+void MaterialArrays::bind(const MaterialArrayGroup& group, unsigned int layer) {
+	for (size_t slot = 0; slot < group.arrays.size(); slot++) {
+		unsigned int& bound = boundArrays[group.units[slot] - MATERIAL_ARRAY_FIRST_UNIT];
+		if (bound == group.arrays[slot]) continue;
+		glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(group.units[slot]));
+		glBindTexture(GL_TEXTURE_2D_ARRAY, group.arrays[slot]);
+		bound = group.arrays[slot];
+	}
+	glActiveTexture(GL_TEXTURE0);
+
+	// attribute arrays a MegaBuffer enabled take precedence over the constant
+	glVertexAttribI1i(MATERIAL_LAYER_ATTRIBUTE, static_cast<GLint>(layer));
+}
@@ -0,0 +1,69 @@
+#ifndef MATERIAL_ARRAYS_H
+#define MATERIAL_ARRAYS_H
+
+#include <glad/glad.h>
+
+#include "material_binding.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// texture units the arrays are bound to, above the ones Mesh::bindMaterial gives plain textures.
+// Samplers of different types may not share a unit, so the two ranges must not overlap. materialArrayUnit
+// gives every array sampler name one of the slots
+#define MATERIAL_ARRAY_FIRST_UNIT 8
+#define MAX_MATERIAL_ARRAY_SLOTS 8
+
+// layer of the mesh's material in model_vShader.vert, a constant per draw or a per vertex
+// stream in a MegaBuffer
+#define MATERIAL_LAYER_ATTRIBUTE 11
+
+class Mesh;
+
+// materials whose textures have the same types, sizes, formats and mip counts. Every slot is one
+// GL_TEXTURE_2D_ARRAY and every material one layer in all of them
+struct MaterialArrayGroup {
+	std::vector<GLint> units;			// per slot, materialArrayUnit of material_diffuse1 and so on, in the meshes' texture order
+	std::vector<unsigned int> arrays;	// per slot
+	unsigned int layers = 0;
+};
+
+struct MaterialArrayStats {
+	unsigned int groups = 0;
+	unsigned int materials = 0;		// layers over all groups
+	unsigned int packedMeshes = 0;
+	unsigned int unpackedMeshes = 0;	// textures didn't match any other material's, still bound one by one
+	size_t bytes = 0;
+};
+
+// Texture arrays of one Model's materials, so meshes only change a layer index between draws
+// instead of rebinding their textures. GL thread only
+class MaterialArrays {
+public:
+	MaterialArrays() {}
+	~MaterialArrays();
+
+	MaterialArrays(const MaterialArrays&) = delete;
+	MaterialArrays& operator=(const MaterialArrays&) = delete;
+
+	// copy the textures of materials that share their shape with at least one other material into
+	// arrays and point the meshes at their group and layer. Meshes of the other materials are left alone,
+	// so are materials with a texture the residency manager has reduced. The arrays count against
+	// its budget but never lose levels. The 2D textures aren't touched, the caller may release the ones
+	// no mesh uses anymore
+	void build(std::vector<Mesh>& meshes);
+
+	const MaterialArrayStats& stats() const { return counters; }
+	void printStats() const;
+
+	// bind a group's arrays, units that already hold them are skipped, and set the layer attribute.
+	// The samplers are pointed at the units by the mesh's MaterialBinding
+	static void bind(const MaterialArrayGroup& group, unsigned int layer);
+
+private:
+	std::vector<MaterialArrayGroup> groups;
+	MaterialArrayStats counters;
+};
+
+#endif
@@ -0,0 +1,122 @@
+#include "material_binding.h"
+#include "material_arrays.h"
+#include "mesh_data.h"
+#include "texture_residency.h"
+
+static const char* TEXTURE_TYPE_NAMES[TEXTURE_TYPE_COUNT] = { "texture_diffuse", "texture_specular", "texture_normal", "texture_height" };
+static const char* ARRAY_SAMPLER_NAMES[TEXTURE_TYPE_COUNT] = { "material_diffuse", "material_specular", "material_normal", "material_height" };
+
+const char* textureTypeName(TextureType type) {
+	return type < TEXTURE_TYPE_COUNT ? TEXTURE_TYPE_NAMES[type] : "";
+}
+
+const char* textureArraySamplerName(TextureType type) {
+	return type < TEXTURE_TYPE_COUNT ? ARRAY_SAMPLER_NAMES[type] : "";
+}
+
+bool textureTypeFromName(const std::string& name, TextureType& type) {
+	for (int t = 0; t < TEXTURE_TYPE_COUNT; t++) {
+		if (name == TEXTURE_TYPE_NAMES[t]) {
+			type = static_cast<TextureType>(t);
+			return true;
+		}
+	}
+	return false;
+}
+
+GLint materialTextureUnit(TextureType type, unsigned int number) {
+	if (type >= TEXTURE_TYPE_COUNT || number == 0 || number > MATERIAL_TEXTURES_PER_TYPE) return -1;
+	return static_cast<GLint>(type * MATERIAL_TEXTURES_PER_TYPE + number - 1);
+}
+
+GLint materialArrayUnit(TextureType type, unsigned int number) {
+	GLint unit = materialTextureUnit(type, number);
+	return unit < 0 ? -1 : MATERIAL_ARRAY_FIRST_UNIT + unit;
+}
+
+static_assert(TEXTURE_TYPE_COUNT * MATERIAL_TEXTURES_PER_TYPE <= MATERIAL_ARRAY_FIRST_UNIT, "plain sampler units run into the array units");
+static_assert(TEXTURE_TYPE_COUNT * MATERIAL_TEXTURES_PER_TYPE <= MAX_MATERIAL_ARRAY_SLOTS, "array sampler units run past the array slots");
+
+// per mesh uniforms of model_vShader.vert and model_fShader.frag
+static constexpr UniformName MATERIAL_ARRAYS_UNIFORM("materialArrays");
+static constexpr UniformName POSITION_OFFSET_UNIFORM("positionOffset");
+static constexpr UniformName POSITION_SCALE_UNIFORM("positionScale");
+static constexpr UniformName SKINNED_UNIFORM("skinned");
+static constexpr UniformName INSTANCED_UNIFORM("instanced");
+
+#define MATERIAL_UNIFORM_ARRAYS 1u
+#define MATERIAL_UNIFORM_OFFSET 2u
+#define MATERIAL_UNIFORM_SCALE 4u
+#define MATERIAL_UNIFORM_SKINNED 8u
+#define MATERIAL_UNIFORM_INSTANCED 16u
+
+// texture_diffuse1, material_diffuse1 and so on with their units, built once
+struct SamplerUnit {
+	std::string name;
+	GLint unit;
+};
+
+static const std::vector<SamplerUnit>& samplerUnits() {
+	static const std::vector<SamplerUnit> units = []() {
+		std::vector<SamplerUnit> list;
+		for (int t = 0; t < TEXTURE_TYPE_COUNT; t++) {
+			TextureType type = static_cast<TextureType>(t);
+			for (unsigned int number = 1; number <= MATERIAL_TEXTURES_PER_TYPE; number++) {
+				list.push_back({ TEXTURE_TYPE_NAMES[t] + std::to_string(number), materialTextureUnit(type, number) });
+				list.push_back({ ARRAY_SAMPLER_NAMES[t] + std::to_string(number), materialArrayUnit(type, number) });
+			}
+		}
+		return list;
+	}();
+	return units;
+}
+
+void MaterialBinding::setup(const Mesh& mesh) {
+	// numbered per type in the order the textures come, texture_diffuse1, texture_diffuse2...
+	units.clear();
+	unsigned int numbers[TEXTURE_TYPE_COUNT] = {};
+	for (const Texture& texture : mesh.textures) {
+		units.push_back(texture.type < TEXTURE_TYPE_COUNT ? materialTextureUnit(texture.type, ++numbers[texture.type]) : -1);
+	}
+}
+
+void MaterialBinding::useProgram(const Shader& shader) {
+	program = shader.ID;
+
+	// the units are the same for every mesh, the Shader's shadow skips them after the first one
+	for (const SamplerUnit& sampler : samplerUnits()) {
+		if (shader.location(sampler.name) >= 0) shader.setInt(sampler.name, sampler.unit);
+	}
+
+	uniforms = 0;
+	if (shader.location(MATERIAL_ARRAYS_UNIFORM) >= 0) uniforms |= MATERIAL_UNIFORM_ARRAYS;
+	if (shader.location(POSITION_OFFSET_UNIFORM) >= 0) uniforms |= MATERIAL_UNIFORM_OFFSET;
+	if (shader.location(POSITION_SCALE_UNIFORM) >= 0) uniforms |= MATERIAL_UNIFORM_SCALE;
+	if (shader.location(SKINNED_UNIFORM) >= 0) uniforms |= MATERIAL_UNIFORM_SKINNED;
+	if (shader.location(INSTANCED_UNIFORM) >= 0) uniforms |= MATERIAL_UNIFORM_INSTANCED;
+}
+
+void MaterialBinding::apply(const Shader& shader, const Mesh& mesh, bool instanced) {
+	if (program != shader.ID) useProgram(shader);
+
+	// packed materials only switch the layer, the arrays stay bound from mesh to mesh
+	if (mesh.materialGroup) {
+		MaterialArrays::bind(*mesh.materialGroup, mesh.materialLayer);
+	}
+	else {
+		for (size_t i = 0; i < units.size(); i++) {
+			if (units[i] < 0) continue;
+			glActiveTexture(GL_TEXTURE0 + units[i]);
+			glBindTexture(GL_TEXTURE_2D, mesh.textures[i].id);
+			TextureResidency::shared().touch(mesh.textures[i].id);
+		}
+		glActiveTexture(GL_TEXTURE0); // restore default active texture
+	}
+
+	// identity for full vertices, model_vShader.vert always applies it. Unchanged values are skipped by the Shader
+	if (uniforms & MATERIAL_UNIFORM_ARRAYS) shader.setBool(MATERIAL_ARRAYS_UNIFORM, mesh.materialGroup != nullptr);
+	if (uniforms & MATERIAL_UNIFORM_OFFSET) shader.setVec3(POSITION_OFFSET_UNIFORM, mesh.positionOffset);
+	if (uniforms & MATERIAL_UNIFORM_SCALE) shader.setVec3(POSITION_SCALE_UNIFORM, mesh.positionScale);
+	if (uniforms & MATERIAL_UNIFORM_SKINNED) shader.setBool(SKINNED_UNIFORM, mesh.skinned);
+	if (uniforms & MATERIAL_UNIFORM_INSTANCED) shader.setBool(INSTANCED_UNIFORM, instanced);
+}
@@ -0,0 +1,60 @@
+#ifndef MATERIAL_BINDING_H
+#define MATERIAL_BINDING_H
+
+#include <glad/glad.h>
+
+#include "shader_class.h"
+
+#include <string>
+#include <vector>
+
+// what a material texture is used for, decides the sampler it is bound to
+enum TextureType {
+	TEXTURE_DIFFUSE,
+	TEXTURE_SPECULAR,
+	TEXTURE_NORMAL,
+	TEXTURE_HEIGHT,
+	TEXTURE_TYPE_COUNT
+};
+
+// texture_diffuse and so on, the sampler prefix in the shaders and the name caches and packages store
+const char* textureTypeName(TextureType type);
+// material_diffuse and so on, the sampler2DArray a packed material is read from
+const char* textureArraySamplerName(TextureType type);
+// false for names no type has, type is left alone
+bool textureTypeFromName(const std::string& name, TextureType& type);
+
+// samplers of one type a material can have, texture_diffuse1 and texture_diffuse2 and so on
+#define MATERIAL_TEXTURES_PER_TYPE 2
+
+// Every sampler name has a texture unit of its own, so all meshes drawn with a program agree on the
+// units and samplers of different types never share one. number starts at 1 like the names, -1 past
+// MATERIAL_TEXTURES_PER_TYPE
+GLint materialTextureUnit(TextureType type, unsigned int number);
+GLint materialArrayUnit(TextureType type, unsigned int number);
+
+class Mesh;
+
+// texture units of one mesh and the per mesh uniforms its program has. The units are worked out
+// when the mesh is set up, drawing only binds textures and sets values through the Shader's setters
+class MaterialBinding {
+public:
+	// units of the mesh's textures from their types and order, call once the textures are assigned
+	void setup(const Mesh& mesh);
+
+	// a deleted program's ID may come back for a new one, invalidate after re-creating a Shader
+	void invalidate() { program = 0; }
+
+	// bind the mesh's textures, or its arrays and layer, and set the per mesh uniforms. The program has to be in use.
+	// The first time the mesh is drawn with a program its sampler uniforms are pointed at their units
+	void apply(const Shader& shader, const Mesh& mesh, bool instanced);
+
+private:
+	unsigned int program = 0;
+	unsigned int uniforms = 0;		// MATERIAL_UNIFORM_* the program has, the others are not set
+	std::vector<GLint> units;		// per texture, -1 for the ones no sampler reads
+
+	void useProgram(const Shader& shader);
+};
+
+#endif
@@ -0,0 +1,297 @@
+#include "mega_buffer.h"
+#include "gl_extensions.h"
+#include "material_arrays.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+MegaBuffer::MegaBuffer(VertexFormat format, const glm::vec3& boundsMin, const glm::vec3& boundsMax) : format(format) {
+	// every packed mesh has to decode with the same uniforms, so compact positions use the Model's bounds
+	quantizationBox(boundsMin, boundsMax, positionOffset, positionScale);
+	if (format != VERTEX_FORMAT_COMPACT) {
+		positionOffset = glm::vec3(0.0f);
+		positionScale = glm::vec3(1.0f);
+	}
+	vertexStride = format == VERTEX_FORMAT_COMPACT ? sizeof(CompactVertex) : sizeof(Vertex);
+
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glGenBuffers(1, &EBO);
+
+	glBindVertexArray(VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+	setupVertexAttributes(format);
+	glBindVertexArray(0);
+}
+
+MegaBuffer::~MegaBuffer() {
+	glDeleteVertexArrays(1, &VAO);
+	glDeleteBuffers(1, &VBO);
+	glDeleteBuffers(1, &EBO);
+	if (layerVBO) glDeleteBuffers(1, &layerVBO);
+	if (indirectBuffer) glDeleteBuffers(1, &indirectBuffer);
+}
+
+// copy the used part into a bigger buffer, the caller points the VAO at the new one
+void MegaBuffer::growBuffer(unsigned int& buffer, size_t usedBytes, size_t newBytes) {
+	unsigned int grown;
+	glGenBuffers(1, &grown);
+	glBindBuffer(GL_COPY_WRITE_BUFFER, grown);
+	glBufferData(GL_COPY_WRITE_BUFFER, newBytes, nullptr, GL_STATIC_DRAW);
+
+	if (usedBytes > 0) {
+		glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, usedBytes);
+	}
+
+	glDeleteBuffers(1, &buffer);
+	buffer = grown;
+}
+
+void MegaBuffer::reserve(size_t numVertices, size_t numIndices) {
+	if (numVertices <= vertexCapacity && numIndices <= indexCapacity) return;
+
+	glBindVertexArray(VAO);
+	if (numVertices > vertexCapacity) {
+		growBuffer(VBO, vertexCount * vertexStride, numVertices * vertexStride);
+		vertexCapacity = numVertices;
+
+		glBindBuffer(GL_ARRAY_BUFFER, VBO);
+		setupVertexAttributes(format);
+
+		if (layerVBO) {
+			growBuffer(layerVBO, vertexCount * sizeof(uint16_t), numVertices * sizeof(uint16_t));
+			glBindBuffer(GL_ARRAY_BUFFER, layerVBO);
+			glVertexAttribIPointer(MATERIAL_LAYER_ATTRIBUTE, 1, GL_UNSIGNED_SHORT, 0, (void*)0);
+		}
+	}
+	if (numIndices > indexCapacity) {
+		growBuffer(EBO, indexCount * sizeof(uint16_t), numIndices * sizeof(uint16_t));
+		indexCapacity = numIndices;
+
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+	}
+	glBindVertexArray(0);
+}
+
+bool MegaBuffer::canPack(const Vertex* vertices, size_t numVertices) const {
+	if (numVertices > MAX_SHORT_INDEX_VERTICES) return false;
+	if (format != VERTEX_FORMAT_COMPACT) return true;
+	return !hasBoneWeights(vertices, numVertices);
+}
+
+Mesh MegaBuffer::append(const Vertex* vertices, size_t numVertices, const unsigned int* indices, size_t numIndices, std::vector<Texture> textures,
+	const std::vector<MeshLod>& lods) {
+	// double the capacity so streaming meshes in one by one stays linear
+	size_t neededVertices = vertexCount + numVertices;
+	size_t neededIndices = indexCount + numIndices;
+	if (neededVertices > vertexCapacity || neededIndices > indexCapacity) {
+		reserve(neededVertices > vertexCapacity ? std::max(neededVertices, vertexCapacity * 2) : vertexCapacity,
+			neededIndices > indexCapacity ? std::max(neededIndices, indexCapacity * 2) : indexCapacity);
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, VBO);
+	if (format == VERTEX_FORMAT_COMPACT) {
+		std::vector<CompactVertex> compact(numVertices);
+		encodeCompactVertices(vertices, numVertices, positionOffset, positionScale, compact.data());
+		glBufferSubData(GL_COPY_WRITE_BUFFER, vertexCount * vertexStride, numVertices * vertexStride, compact.data());
+	}
+	else {
+		glBufferSubData(GL_COPY_WRITE_BUFFER, vertexCount * vertexStride, numVertices * vertexStride, vertices);
+	}
+
+	if (layerVBO) {
+		std::vector<uint16_t> layers(numVertices, 0);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, layerVBO);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, vertexCount * sizeof(uint16_t), numVertices * sizeof(uint16_t), layers.data());
+	}
+
+	glBindBuffer(GL_COPY_WRITE_BUFFER, EBO);
+	std::vector<uint16_t> shortIndices(indices, indices + numIndices);
+	glBufferSubData(GL_COPY_WRITE_BUFFER, indexCount * sizeof(uint16_t), numIndices * sizeof(uint16_t), shortIndices.data());
+
+	Mesh mesh;
+	mesh.VAO = VAO;
+	mesh.textures = std::move(textures);
+	mesh.material.setup(mesh);
+	mesh.setGeometry(vertices, numVertices, numIndices, lods);
+	mesh.firstIndex = static_cast<unsigned int>(indexCount);
+	mesh.baseVertex = static_cast<int>(vertexCount);
+	mesh.format = format;
+	mesh.positionOffset = positionOffset;
+	mesh.positionScale = positionScale;
+	mesh.vertexBytes = numVertices * vertexStride;
+	mesh.indexType = GL_UNSIGNED_SHORT;
+	mesh.indexBytes = numIndices * sizeof(uint16_t);
+	mesh.skinned = hasBoneWeights(vertices, numVertices);
+
+	vertexCount += numVertices;
+	indexCount += numIndices;
+	batchesDirty = true;
+	return mesh;
+}
+
+void MegaBuffer::setMaterialLayers(const std::vector<Mesh>& meshes) {
+	std::vector<uint16_t> layers(vertexCapacity, 0);
+	for (const Mesh& mesh : meshes) {
+		if (!owns(mesh) || !mesh.materialGroup) continue;
+		size_t numVertices = mesh.vertexBytes / vertexStride;
+		std::fill(layers.begin() + mesh.baseVertex, layers.begin() + mesh.baseVertex + numVertices, static_cast<uint16_t>(mesh.materialLayer));
+	}
+
+	glBindVertexArray(VAO);
+	if (!layerVBO) glGenBuffers(1, &layerVBO);
+	glBindBuffer(GL_ARRAY_BUFFER, layerVBO);
+	glBufferData(GL_ARRAY_BUFFER, layers.size() * sizeof(uint16_t), layers.data(), GL_STATIC_DRAW);
+	glEnableVertexAttribArray(MATERIAL_LAYER_ATTRIBUTE);
+	glVertexAttribIPointer(MATERIAL_LAYER_ATTRIBUTE, 1, GL_UNSIGNED_SHORT, 0, (void*)0);
+	glBindVertexArray(0);
+
+	batchesDirty = true;
+}
+
+void MegaBuffer::buildBatches(const std::vector<Mesh>& meshes, const glm::mat4* transforms) {
+	batches.clear();
+
+	std::map<std::vector<unsigned int>, size_t> batchByTextures;
+	for (size_t i = 0; i < meshes.size(); i++) {
+		const Mesh& mesh = meshes[i];
+		if (!owns(mesh)) continue;
+
+		// the skinned flag is a uniform too, it goes last in the key. Packed materials are keyed by their
+		// arrays, behind a 0 no texture name can have, the layer comes from the vertices
+		std::vector<unsigned int> textureIDs;
+		if (mesh.materialGroup && layerVBO) {
+			textureIDs.push_back(0);
+			for (unsigned int array : mesh.materialGroup->arrays) textureIDs.push_back(array);
+		}
+		else {
+			for (const Texture& texture : mesh.textures) textureIDs.push_back(texture.id);
+		}
+		textureIDs.push_back(mesh.skinned ? 1 : 0);
+
+		// so is the model matrix, meshes only share a batch when their transforms are the same
+		if (transforms) {
+			unsigned int matrixBits[16];
+			std::memcpy(matrixBits, &transforms[i][0][0], sizeof(matrixBits));
+			textureIDs.insert(textureIDs.end(), matrixBits, matrixBits + 16);
+		}
+
+		auto found = batchByTextures.find(textureIDs);
+		if (found == batchByTextures.end()) {
+			found = batchByTextures.emplace(textureIDs, batches.size()).first;
+			batches.push_back(Batch());
+		}
+		batches[found->second].members.push_back(i);
+	}
+
+	// indirect commands are laid out batch after batch
+	size_t numCommands = 0;
+	for (Batch& batch : batches) {
+		batch.firstCommand = numCommands;
+		numCommands += batch.members.size();
+	}
+	if (glExtensions().multiDrawIndirect && !indirectBuffer) glGenBuffers(1, &indirectBuffer);
+	uploadedCommands.clear();
+
+	batchedByTransform = transforms != nullptr;
+	batchesDirty = false;
+}
+
+void MegaBuffer::updateTransforms(const glm::mat4* transforms) {
+	if (batchesDirty || !batchedByTransform || !transforms) return;
+
+	// meshes under one node move together, so a batch only splits when nodes that happened to match move apart
+	for (const Batch& batch : batches) {
+		const glm::mat4& shared = transforms[batch.members.front()];
+		for (size_t i = 1; i < batch.members.size(); i++) {
+			if (std::memcmp(&transforms[batch.members[i]], &shared, sizeof(glm::mat4)) != 0) {
+				batchesDirty = true;
+				return;
+			}
+		}
+	}
+}
+
+void MegaBuffer::draw(Shader& shader, std::vector<Mesh>& meshes, const InstanceBuffer* instances, const uint8_t* visible,
+	const glm::mat4* transforms, const glm::mat4& model) {
+	if (batchesDirty) buildBatches(meshes, transforms);
+	if (batches.empty()) return;
+
+	GLsizei instanceCount = instances ? static_cast<GLsizei>(instances->count()) : 1;
+	if (instanceCount == 0) return;
+	if (instances && instanceBuffer != instances->id()) {
+		instances->attach(VAO);
+		instanceBuffer = instances->id();
+	}
+
+	// the ranges follow the LOD each mesh picked for this frame, culled meshes are left out
+	const GLExtensions& extensions = glExtensions();
+	commands.clear();
+	for (Batch& batch : batches) {
+		batch.counts.clear();
+		batch.offsets.clear();
+		batch.baseVertices.clear();
+		for (size_t member : batch.members) {
+			const Mesh& mesh = meshes[member];
+			bool shown = !visible || visible[member];
+			if (shown) {
+				batch.counts.push_back(static_cast<GLsizei>(mesh.drawIndexCount()));
+				batch.offsets.push_back((const void*)(mesh.drawFirstIndex() * sizeof(uint16_t)));
+				batch.baseVertices.push_back(mesh.baseVertex);
+			}
+
+			// the command layout stays fixed, a culled mesh just draws no instances
+			if (extensions.multiDrawIndirect) {
+				DrawCommand command;
+				command.count = mesh.drawIndexCount();
+				command.instanceCount = shown ? instanceCount : 0;
+				command.firstIndex = mesh.drawFirstIndex();
+				command.baseVertex = mesh.baseVertex;
+				command.baseInstance = 0;
+				commands.push_back(command);
+			}
+		}
+	}
+
+	if (extensions.multiDrawIndirect) {
+		glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+		// only touch the buffer on frames where a LOD or the visibility changed
+		bool changed = commands.size() != uploadedCommands.size()
+			|| std::memcmp(commands.data(), uploadedCommands.data(), commands.size() * sizeof(DrawCommand)) != 0;
+		if (changed) {
+			glBufferData(GL_DRAW_INDIRECT_BUFFER, commands.size() * sizeof(DrawCommand), commands.data(), GL_DYNAMIC_DRAW);
+			uploadedCommands = commands;
+		}
+	}
+
+	glBindVertexArray(VAO);
+	for (const Batch& batch : batches) {
+		if (batch.counts.empty()) continue;	// every member culled
+		meshes[batch.members.front()].bindMaterial(shader, instances != nullptr);
+		if (transforms) {
+			const glm::mat4& transform = transforms[batch.members.front()];
+			shader.setMat4(MODEL_UNIFORM, instances ? transform : model * transform);
+		}
+
+		GLsizei drawCount = static_cast<GLsizei>(batch.counts.size());
+		if (extensions.multiDrawIndirect) {
+			GLsizei commandCount = static_cast<GLsizei>(batch.members.size());
+			extensions.multiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_SHORT, (const void*)(batch.firstCommand * sizeof(DrawCommand)), commandCount, 0);
+		}
+		else if (instances) {
+			// core 3.3 has no instanced multi draw, one instanced call per member
+			for (GLsizei i = 0; i < drawCount; i++) {
+				glDrawElementsInstancedBaseVertex(GL_TRIANGLES, batch.counts[i], GL_UNSIGNED_SHORT, batch.offsets[i], instanceCount, batch.baseVertices[i]);
+			}
+		}
+		else {
+			glMultiDrawElementsBaseVertex(GL_TRIANGLES, batch.counts.data(), GL_UNSIGNED_SHORT, batch.offsets.data(), drawCount, batch.baseVertices.data());
+		}
+	}
+	glBindVertexArray(0);
+
+	if (extensions.multiDrawIndirect) glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
@@ -0,0 +1,91 @@
+#ifndef MEGA_BUFFER_H
+#define MEGA_BUFFER_H
+
+#include "mesh_data.h"
+
+#include <vector>
+
+// One vertex buffer and one index buffer shared by all the meshes of a Model. Meshes packed
+// into it share its VAO and are drawn together, one multi draw call per set of textures and transform.
+// Indices are relative to each mesh's base vertex and always 16 bit. GL thread only
+class MegaBuffer {
+public:
+	MegaBuffer(VertexFormat format, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+	~MegaBuffer();
+
+	MegaBuffer(const MegaBuffer&) = delete;
+	MegaBuffer& operator=(const MegaBuffer&) = delete;
+
+	// grow the buffers ahead of time when the totals are known, avoids copies while appending
+	void reserve(size_t numVertices, size_t numIndices);
+
+	// skinned compact meshes and meshes too big for 16 bit indices keep their own buffers
+	bool canPack(const Vertex* vertices, size_t numVertices) const;
+
+	// copy a mesh into the shared buffers, the returned Mesh points at its range of them
+	Mesh append(const Vertex* vertices, size_t numVertices, const unsigned int* indices, size_t numIndices, std::vector<Texture> textures,
+		const std::vector<MeshLod>& lods = std::vector<MeshLod>());
+
+	// draw every packed mesh of the list at its current LOD, the others are left to the caller.
+	// With instances every mesh is drawn once per uploaded transform, meshes whose visible entry is 0 are skipped.
+	// transforms has one matrix per mesh placing it in the model, the model uniform is set to model * transform
+	// (transform alone when instanced) per batch. Without them the caller's model uniform is left as it is
+	void draw(Shader& shader, std::vector<Mesh>& meshes, const InstanceBuffer* instances = nullptr, const uint8_t* visible = nullptr,
+		const glm::mat4* transforms = nullptr, const glm::mat4& model = glm::mat4(1.0f));
+	bool owns(const Mesh& mesh) const { return mesh.VAO != 0 && mesh.VAO == VAO; }
+
+	// rebuild the batches on the next draw
+	void invalidateBatches() { batchesDirty = true; }
+
+	// call when the transforms passed to draw() changed. Batches hold meshes whose transforms were equal,
+	// as long as every member still matches its batch draw() just reads the new matrix. Only a batch
+	// whose members moved apart is rebuilt
+	void updateTransforms(const glm::mat4* transforms);
+
+	// fill the per vertex material layer stream from the meshes' materialLayer. Meshes sharing texture
+	// arrays are batched together from then on, whatever layer they use. Meshes appended later read layer 0
+	void setMaterialLayers(const std::vector<Mesh>& meshes);
+
+	unsigned int drawCalls() const { return static_cast<unsigned int>(batches.size()); }
+
+private:
+	// packed meshes with the same textures or texture arrays, drawn by one call
+	struct Batch {
+		std::vector<size_t> members;	// indices in the mesh list, the first one's textures are bound
+		std::vector<GLsizei> counts;	// draw ranges, refilled every frame as the LODs change
+		std::vector<const void*> offsets;
+		std::vector<GLint> baseVertices;
+		size_t firstCommand;			// in the indirect buffer
+	};
+
+	// layout of a glMultiDrawElementsIndirect command
+	struct DrawCommand {
+		GLuint count;
+		GLuint instanceCount;
+		GLuint firstIndex;
+		GLint baseVertex;
+		GLuint baseInstance;
+	};
+
+	VertexFormat format;
+	glm::vec3 positionOffset;
+	glm::vec3 positionScale;
+
+	unsigned int VAO = 0, VBO = 0, EBO = 0, indirectBuffer = 0;
+	unsigned int instanceBuffer = 0;	// InstanceBuffer attached to the VAO
+	unsigned int layerVBO = 0;			// uint16 material layer per vertex, 0 until setMaterialLayers
+	size_t vertexStride;
+	size_t vertexCapacity = 0, indexCapacity = 0;
+	size_t vertexCount = 0, indexCount = 0;
+
+	std::vector<Batch> batches;
+	bool batchesDirty = true;
+	bool batchedByTransform = false;	// batches were built with transforms, their members share one
+	std::vector<DrawCommand> commands;			// indirect commands of the current frame
+	std::vector<DrawCommand> uploadedCommands;	// what the indirect buffer holds
+
+	void buildBatches(const std::vector<Mesh>& meshes, const glm::mat4* transforms);
+	static void growBuffer(unsigned int& buffer, size_t usedBytes, size_t newBytes);
+};
+
+#endif
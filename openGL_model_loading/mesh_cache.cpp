@@ -0,0 +1,260 @@
+#include "mesh_cache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+
+namespace fs = std::filesystem;
+
+static const char MESH_CACHE_MAGIC[4] = { 'M', 'S', 'H', 'C' };
+
+static uint64_t alignUp(uint64_t value) {
+	return (value + 15) & ~uint64_t(15);
+}
+
+// FNV-1a over 64 bit words, cheap enough to run over the whole payload on every load
+uint64_t cacheHash(const unsigned char* data, size_t size) {
+	uint64_t hash = 14695981039346656037ull;
+	size_t i = 0;
+	for (; i + 8 <= size; i += 8) {
+		uint64_t word;
+		std::memcpy(&word, data + i, 8);
+		hash = (hash ^ word) * 1099511628211ull;
+	}
+	for (; i < size; i++) {
+		hash = (hash ^ data[i]) * 1099511628211ull;
+	}
+	return hash;
+}
+
+// absolute, normalized path so the same model reached through different relative paths shares an entry
+std::string cacheSourceKey(const std::string& sourcePath) {
+	std::error_code ec;
+	fs::path absolute = fs::absolute(sourcePath, ec);
+	if (ec) return sourcePath;
+	return absolute.lexically_normal().generic_string();
+}
+
+bool cacheSourceStat(const std::string& sourcePath, int64_t& mtime, uint64_t& size) {
+	std::error_code ec;
+	auto time = fs::last_write_time(sourcePath, ec);
+	if (ec) return false;
+	size = fs::file_size(sourcePath, ec);
+	if (ec) return false;
+	mtime = static_cast<int64_t>(time.time_since_epoch().count());
+	return true;
+}
+
+std::string cacheEntryPath(const std::string& key, const char* extension) {
+	std::stringstream name;
+	name << MESH_CACHE_DIR << '/' << std::hex << std::setw(16) << std::setfill('0')
+		<< cacheHash(reinterpret_cast<const unsigned char*>(key.data()), key.size()) << extension;
+	return name.str();
+}
+
+
+bool MeshCache::open(const std::string& sourcePath, unsigned int importFlags, unsigned int processFlags) {
+	close();
+
+	int64_t mtime;
+	uint64_t size;
+	if (!cacheSourceStat(sourcePath, mtime, size)) return false;
+
+	std::string key = cacheSourceKey(sourcePath);
+	if (!file.open(cacheEntryPath(key, ".mcache"))) return false;
+
+	header = reinterpret_cast<const MeshCacheHeader*>(file.data());
+	if (!validate(key, importFlags, processFlags, mtime, size)) {
+		std::cout << "MESH_CACHE::STALE_OR_CORRUPT, reimporting: " << sourcePath << std::endl;
+		close();
+		return false;
+	}
+
+	entries = reinterpret_cast<const MeshCacheEntry*>(file.data() + alignUp(sizeof(MeshCacheHeader) + header->pathLength));
+	return true;
+}
+
+void MeshCache::close() {
+	file.close();
+	header = nullptr;
+	entries = nullptr;
+}
+
+bool MeshCache::validate(const std::string& key, unsigned int importFlags, unsigned int processFlags, int64_t mtime, uint64_t size) const {
+	const uint64_t fileSize = file.size();
+	if (fileSize < sizeof(MeshCacheHeader)) return false;
+
+	if (std::memcmp(header->magic, MESH_CACHE_MAGIC, 4) != 0) return false;
+	if (header->version != MESH_CACHE_VERSION || header->vertexSize != sizeof(Vertex)) return false;
+	if (header->importFlags != importFlags || header->processFlags != processFlags) return false;
+	if (header->sourceMtime != mtime || header->sourceSize != size) return false;
+	if (header->fileSize != fileSize) return false;
+
+	// the stored source path must match, the file name is only a hash of it
+	if (header->pathLength != key.size() || sizeof(MeshCacheHeader) + key.size() > fileSize) return false;
+	if (std::memcmp(file.data() + sizeof(MeshCacheHeader), key.data(), key.size()) != 0) return false;
+
+	uint64_t entriesOffset = alignUp(sizeof(MeshCacheHeader) + header->pathLength);
+	if (entriesOffset + uint64_t(header->meshCount) * sizeof(MeshCacheEntry) > fileSize) return false;
+	const MeshCacheEntry* entryList = reinterpret_cast<const MeshCacheEntry*>(file.data() + entriesOffset);
+
+	if (cacheHash(file.data() + sizeof(MeshCacheHeader), fileSize - sizeof(MeshCacheHeader)) != header->payloadHash) return false;
+
+	// bounds check every block so a truncated or hand edited file can never be read out of range
+	for (unsigned int i = 0; i < header->meshCount; i++) {
+		const MeshCacheEntry& entry = entryList[i];
+		if (entry.vertexOffset % 16 || entry.indexOffset % 16) return false;
+		if (entry.vertexOffset + uint64_t(entry.numVertices) * sizeof(Vertex) > fileSize) return false;
+		if (entry.indexOffset + uint64_t(entry.numIndices) * sizeof(unsigned int) > fileSize) return false;
+		if (entry.textureOffset + entry.textureBytes > fileSize) return false;
+		if (entry.lodOffset + uint64_t(entry.numLods) * sizeof(MeshLod) > fileSize) return false;
+		for (unsigned int l = 0; l < entry.numLods; l++) {
+			MeshLod lod;
+			std::memcpy(&lod, file.data() + entry.lodOffset + l * sizeof(MeshLod), sizeof(MeshLod));
+			if (uint64_t(lod.firstIndex) + lod.indexCount > entry.numIndices) return false;
+		}
+
+		uint64_t cursor = 0;
+		for (unsigned int t = 0; t < entry.numTextures; t++) {
+			uint32_t lengths[2];
+			if (cursor + sizeof(lengths) > entry.textureBytes) return false;
+			std::memcpy(lengths, file.data() + entry.textureOffset + cursor, sizeof(lengths));
+			cursor += sizeof(lengths) + uint64_t(lengths[0]) + lengths[1];
+			if (cursor > entry.textureBytes) return false;
+		}
+	}
+	return true;
+}
+
+CachedMeshView MeshCache::mesh(unsigned int index) const {
+	const MeshCacheEntry& entry = entries[index];
+
+	CachedMeshView view;
+	view.vertices = reinterpret_cast<const Vertex*>(file.data() + entry.vertexOffset);
+	view.numVertices = entry.numVertices;
+	view.indices = reinterpret_cast<const unsigned int*>(file.data() + entry.indexOffset);
+	view.numIndices = entry.numIndices;
+	view.node = entry.node;
+
+	const unsigned char* cursor = file.data() + entry.textureOffset;
+	for (unsigned int t = 0; t < entry.numTextures; t++) {
+		uint32_t lengths[2];
+		std::memcpy(lengths, cursor, sizeof(lengths));
+		cursor += sizeof(lengths);
+
+		// the type is stored by name, entries stay readable if the enum is reordered
+		TextureRef texture;
+		bool known = textureTypeFromName(std::string(reinterpret_cast<const char*>(cursor), lengths[0]), texture.type);
+		cursor += lengths[0];
+		texture.path.assign(reinterpret_cast<const char*>(cursor), lengths[1]);
+		cursor += lengths[1];
+		if (known) view.textures.push_back(texture);
+	}
+
+	view.lods.resize(entry.numLods);
+	if (entry.numLods > 0) std::memcpy(view.lods.data(), file.data() + entry.lodOffset, entry.numLods * sizeof(MeshLod));
+	return view;
+}
+
+
+bool MeshCache::write(const std::string& sourcePath, unsigned int importFlags, const std::vector<const MeshData*>& meshes, unsigned int processFlags) {
+	MeshCacheHeader header{};
+	std::memcpy(header.magic, MESH_CACHE_MAGIC, 4);
+	header.version = MESH_CACHE_VERSION;
+	header.vertexSize = sizeof(Vertex);
+	header.importFlags = importFlags;
+	header.processFlags = processFlags;
+	if (!cacheSourceStat(sourcePath, header.sourceMtime, header.sourceSize)) return false;
+
+	std::string key = cacheSourceKey(sourcePath);
+	header.pathLength = static_cast<uint32_t>(key.size());
+	header.meshCount = static_cast<uint32_t>(meshes.size());
+
+	// lay out every block first so the file can be filled in a single buffer
+	std::vector<MeshCacheEntry> entryList(meshes.size());
+	uint64_t offset = alignUp(alignUp(sizeof(MeshCacheHeader) + key.size()) + meshes.size() * sizeof(MeshCacheEntry));
+
+	for (size_t i = 0; i < meshes.size(); i++) {
+		const MeshData& mesh = *meshes[i];
+		MeshCacheEntry& entry = entryList[i];
+
+		entry.numVertices = static_cast<uint32_t>(mesh.vertices.size());
+		entry.vertexOffset = offset;
+		offset = alignUp(offset + mesh.vertices.size() * sizeof(Vertex));
+
+		entry.numIndices = static_cast<uint32_t>(mesh.indices.size());
+		entry.indexOffset = offset;
+		offset = alignUp(offset + mesh.indices.size() * sizeof(unsigned int));
+
+		entry.numTextures = static_cast<uint32_t>(mesh.textures.size());
+		entry.textureOffset = offset;
+		entry.textureBytes = 0;
+		for (const TextureRef& texture : mesh.textures) {
+			entry.textureBytes += static_cast<uint32_t>(2 * sizeof(uint32_t) + std::strlen(textureTypeName(texture.type)) + texture.path.size());
+		}
+		offset = alignUp(offset + entry.textureBytes);
+
+		entry.numLods = static_cast<uint32_t>(mesh.lods.size());
+		entry.lodOffset = offset;
+		entry.node = mesh.node;
+		offset = alignUp(offset + mesh.lods.size() * sizeof(MeshLod));
+	}
+	header.fileSize = offset;
+
+	std::vector<unsigned char> buffer(offset, 0);
+	std::memcpy(buffer.data() + sizeof(MeshCacheHeader), key.data(), key.size());
+	std::memcpy(buffer.data() + alignUp(sizeof(MeshCacheHeader) + key.size()), entryList.data(), entryList.size() * sizeof(MeshCacheEntry));
+
+	for (size_t i = 0; i < meshes.size(); i++) {
+		const MeshData& mesh = *meshes[i];
+		const MeshCacheEntry& entry = entryList[i];
+
+		if (!mesh.vertices.empty())
+			std::memcpy(buffer.data() + entry.vertexOffset, mesh.vertices.data(), mesh.vertices.size() * sizeof(Vertex));
+		if (!mesh.indices.empty())
+			std::memcpy(buffer.data() + entry.indexOffset, mesh.indices.data(), mesh.indices.size() * sizeof(unsigned int));
+
+		unsigned char* cursor = buffer.data() + entry.textureOffset;
+		for (const TextureRef& texture : mesh.textures) {
+			const char* type = textureTypeName(texture.type);
+			uint32_t lengths[2] = { static_cast<uint32_t>(std::strlen(type)), static_cast<uint32_t>(texture.path.size()) };
+			std::memcpy(cursor, lengths, sizeof(lengths));
+			cursor += sizeof(lengths);
+			std::memcpy(cursor, type, lengths[0]);
+			cursor += lengths[0];
+			std::memcpy(cursor, texture.path.data(), texture.path.size());
+			cursor += texture.path.size();
+		}
+
+		if (!mesh.lods.empty())
+			std::memcpy(buffer.data() + entry.lodOffset, mesh.lods.data(), mesh.lods.size() * sizeof(MeshLod));
+	}
+
+	header.payloadHash = cacheHash(buffer.data() + sizeof(MeshCacheHeader), buffer.size() - sizeof(MeshCacheHeader));
+	std::memcpy(buffer.data(), &header, sizeof(MeshCacheHeader));
+
+	std::error_code ec;
+	fs::create_directories(MESH_CACHE_DIR, ec);
+
+	std::string cachePath = cacheEntryPath(key, ".mcache");
+	std::string tempPath = cachePath + ".tmp";
+	{
+		std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+		out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+		if (!out) {
+			std::cout << "ERROR::MESH_CACHE::WRITE_FAILED: " << tempPath << std::endl;
+			return false;
+		}
+	}
+
+	fs::rename(tempPath, cachePath, ec);
+	if (ec) {
+		std::cout << "ERROR::MESH_CACHE::WRITE_FAILED: " << ec.message() << std::endl;
+		fs::remove(tempPath, ec);
+		return false;
+	}
+	return true;
+}
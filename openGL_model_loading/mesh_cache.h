@@ -0,0 +1,87 @@
+#ifndef MESH_CACHE_H
+#define MESH_CACHE_H
+
+#include "mesh_data.h"
+#include "mapped_file.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// directory (relative to the working directory) where processed meshes are cached
+#define MESH_CACHE_DIR "mesh_cache"
+#define MESH_CACHE_VERSION 6	// 2: bone ids/weights are initialized, 3: process flags, 4: LOD tables, 5: bone weights imported, 6: mesh nodes
+
+// processing applied after the import, part of the cache key like the import flags
+#define MESH_PROCESS_OPTIMIZED 0x1	// vertex cache, overdraw and vertex fetch optimization
+#define MESH_PROCESS_LODS 0x2		// LOD chain appended to the indices, the high 16 bits hash its ratios
+
+
+// On-disk layout of a cache entry, every block is 16 bytes aligned:
+// [MeshCacheHeader][source path][MeshCacheEntry * meshCount][vertices/indices/textures of each mesh]
+struct MeshCacheHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t vertexSize;		// sizeof(Vertex) when written, catches layout changes
+	uint32_t importFlags;		// assimp post process flags used for the import
+	int64_t sourceMtime;
+	uint64_t sourceSize;
+	uint64_t fileSize;
+	uint64_t payloadHash;		// hash of everything after the header
+	uint32_t pathLength;
+	uint32_t meshCount;
+	uint32_t processFlags;		// MESH_PROCESS_* steps run on the meshes
+	uint32_t reserved;
+};
+
+struct MeshCacheEntry {
+	uint64_t vertexOffset;
+	uint64_t indexOffset;
+	uint64_t textureOffset;
+	uint32_t numVertices;
+	uint32_t numIndices;
+	uint32_t numTextures;
+	uint32_t textureBytes;		// textures are stored as [uint32 typeLength][uint32 pathLength][type][path]
+	uint64_t lodOffset;			// MeshLod * numLods
+	uint32_t numLods;
+	uint32_t node;				// index of the node the mesh hangs from, depth first like Skeleton::nodes
+};
+
+// view into the mapped pages of one cached mesh, only valid while the MeshCache is open
+struct CachedMeshView {
+	const Vertex* vertices;
+	unsigned int numVertices;
+	const unsigned int* indices;
+	unsigned int numIndices;
+	std::vector<TextureRef> textures;
+	std::vector<MeshLod> lods;
+	unsigned int node;
+};
+
+// helpers shared with the other caches kept next to a mesh entry
+std::string cacheSourceKey(const std::string& sourcePath);	// absolute normalized path
+std::string cacheEntryPath(const std::string& sourceKey, const char* extension);
+bool cacheSourceStat(const std::string& sourcePath, int64_t& mtime, uint64_t& size);
+uint64_t cacheHash(const unsigned char* data, size_t size);
+
+class MeshCache {
+public:
+	// map and validate the cache entry of a source model, false when it is missing, stale or corrupt
+	bool open(const std::string& sourcePath, unsigned int importFlags, unsigned int processFlags = 0);
+	void close();
+
+	unsigned int meshCount() const { return header ? header->meshCount : 0; }
+	CachedMeshView mesh(unsigned int index) const;
+
+	// serialize the processed meshes of a model, written to a temporary file and renamed into place
+	static bool write(const std::string& sourcePath, unsigned int importFlags, const std::vector<const MeshData*>& meshes, unsigned int processFlags = 0);
+
+private:
+	MappedFile file;
+	const MeshCacheHeader* header = nullptr;
+	const MeshCacheEntry* entries = nullptr;
+
+	bool validate(const std::string& sourceKey, unsigned int importFlags, unsigned int processFlags, int64_t mtime, uint64_t size) const;
+};
+
+#endif
@@ -12,9 +12,20 @@
 #include "camera_class.h"
 #include "primitive_cube.h"
 #include "stb_image.h"
+#include "texture_loader.h"
+#include "instance_buffer.h"
+#include "material_binding.h"
+
+#include <cstdint>
 
 #define MAX_BONE_INFLUENCE 4
 
+// meshes with at most this many vertices use 16 bit indices
+#define MAX_SHORT_INDEX_VERTICES 65536
+
+// node transform uniform of model_vShader.vert, set per node while drawing so hashed once here
+constexpr UniformName MODEL_UNIFORM("model");
+
 
 struct Vertex {
 	glm::vec3 Position;
@@ -30,33 +41,174 @@ struct Vertex {
 	float m_Weights[MAX_BONE_INFLUENCE];
 };
 
+// layout of the vertex buffer a Mesh uploads
+enum VertexFormat {
+	VERTEX_FORMAT_FULL,		// Vertex as it is, 88 bytes
+	VERTEX_FORMAT_COMPACT	// CompactVertex, 20 bytes, plus a CompactSkin stream when the mesh is skinned
+};
+
+// quantized vertex: position is unorm16 inside the mesh bounds with the bitangent sign in w,
+// normal and tangent are octahedral snorm16 and the texture coords half floats
+struct CompactVertex {
+	uint16_t Position[4];
+	int16_t Normal[2];
+	int16_t Tangent[2];
+	uint16_t TexCoords[2];
+};
+
+// bone data of a compact skinned mesh, kept in a second buffer so static meshes don't pay for it
+struct CompactSkin {
+	uint16_t BoneIDs[MAX_BONE_INFLUENCE];
+	uint8_t Weights[MAX_BONE_INFLUENCE];
+};
+
+struct MaterialArrayGroup;
+
 struct Texture {
 	unsigned int id;
-	std::string type;
+	TextureType type;
 	std::string path;
 };
 
+// texture a mesh refers to before it is loaded on the GL thread
+struct TextureRef {
+	TextureType type;
+	std::string path;
+	DecodedImageFuture image;	// decode already running on the worker pool, empty when none was started
+	CompressedImageFuture compressed;	// block cache read or encode behind the decode, empty unless textures are compressed
+};
+
+// level of detail of a mesh, a range of its index buffer
+struct MeshLod {
+	unsigned int firstIndex;	// relative to the mesh's own first index
+	unsigned int indexCount;
+	float error;				// object space distance the level may be off from the full mesh
+};
+
+// CPU side result of processing one mesh, safe to build off the GL thread
+struct MeshData {
+	std::vector<Vertex> vertices;
+	std::vector<unsigned int> indices;	// full detail triangles followed by the other LOD levels, if any
+	std::vector<TextureRef> textures;
+	std::vector<MeshLod> lods;			// empty when no LOD chain was built
+	unsigned int node = 0;				// scene node the mesh is attached to, index in Model::nodes
+};
+
 class Mesh {
 public: 
 	std::vector<Vertex>	vertices;
-	std::vector<unsigned int> indices;
+	std::vector<unsigned int> indices;		// CPU copy in the type of the index buffer, only one of the two is filled
+	std::vector<uint16_t> shortIndices;
 	std::vector<Texture> textures;
-	unsigned int VAO;
+	unsigned int VAO = 0;
+	unsigned int indexCount = 0;
+	unsigned int firstIndex = 0;	// offsets into the buffers, non zero when the VAO is shared with other meshes
+	int baseVertex = 0;
+
+	std::vector<MeshLod> lods;		// level 0 is the full mesh, indexCount triangles
+	unsigned int currentLod = 0;	// level Draw uses
+	glm::vec3 boundsMin = glm::vec3(0.0f);	// object space
+	glm::vec3 boundsMax = glm::vec3(0.0f);
+	glm::vec3 sphereCenter = glm::vec3(0.0f);	// object space bounding sphere, what culling tests
+	float sphereRadius = 0.0f;
 
-	// constructor
-	Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures) {
-		this->vertices = vertices;
-		this->textures = textures;
-		this->indices = indices;
+	VertexFormat format = VERTEX_FORMAT_FULL;
+	glm::vec3 positionOffset = glm::vec3(0.0f);	// compact positions are offset + unorm * scale
+	glm::vec3 positionScale = glm::vec3(1.0f);
+	size_t vertexBytes = 0;						// GPU memory taken by the vertex streams
+	GLenum indexType = GL_UNSIGNED_INT;			// GL_UNSIGNED_SHORT when every vertex fits in 16 bits
+	size_t indexBytes = 0;
 
-		setupMesh();
+	bool skinned = false;		// model_vShader.vert blends the bone palette with attributes 5 and 6
+	bool cpuSkinned = false;	// posed on the CPU instead, the vertex buffer is rewritten every frame
+	unsigned int instanceBuffer = 0;	// InstanceBuffer the VAO's instance attributes point at, 0 until drawn instanced
+	unsigned int node = 0;				// index in Model::nodes, its world matrix places the mesh
+	const MaterialArrayGroup* materialGroup = nullptr;	// texture arrays holding the material, null when textures are bound one by one
+	unsigned int materialLayer = 0;						// the material's layer in them
+	MaterialBinding material;							// texture units, set up with the textures
+
+	// empty placeholder, not drawable until a real mesh is assigned to it
+	Mesh() {}
+
+	// takes over the vectors, pass them with std::move to avoid copying the geometry
+	Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures, VertexFormat format = VERTEX_FORMAT_FULL,
+		const std::vector<MeshLod>& lods = std::vector<MeshLod>()) {
+		this->textures = std::move(textures);
+		material.setup(*this);
+
+		setGeometry(vertices.data(), vertices.size(), indices.size(), lods);
+		setupMesh(vertices.data(), vertices.size(), indices.data(), indices.size(), format);
+		keepGeometry(std::move(vertices), std::move(indices));
 	}
 
+	// upload straight from externally owned memory (e.g. mapped cache pages), no CPU copy is kept
+	Mesh(const Vertex* vertices, size_t numVertices, const unsigned int* indices, size_t numIndices, std::vector<Texture> textures, VertexFormat format = VERTEX_FORMAT_FULL,
+		const std::vector<MeshLod>& lods = std::vector<MeshLod>()) {
+		this->textures = std::move(textures);
+		material.setup(*this);
+
+		setGeometry(vertices, numVertices, numIndices, lods);
+		setupMesh(vertices, numVertices, indices, numIndices, format);
+	}
+
+	// the GL objects belong to one Mesh, so it can only be moved
+	~Mesh();
+	Mesh(const Mesh&) = delete;
+	Mesh& operator=(const Mesh&) = delete;
+	Mesh(Mesh&& other) noexcept;
+	Mesh& operator=(Mesh&& other) noexcept;
+
+	// adopt the CPU copy of already uploaded geometry, indices are narrowed to the buffer's type
+	void keepGeometry(std::vector<Vertex>&& vertexData, std::vector<unsigned int>&& indexData);
+	// free the CPU copy, drawing only needs the GPU buffers
+	void releaseGeometry();
+	bool hasGeometry() const { return !vertices.empty(); }
+
 	void Draw(Shader& shader);
 
+	// draw one copy per transform in instances with a single call, the model uniform is ignored
+	void DrawInstanced(Shader& shader, const InstanceBuffer& instances);
+	// same after uploading the transforms, the buffer is reused from frame to frame
+	void DrawInstanced(Shader& shader, InstanceBuffer& instances, const glm::mat4* transforms, size_t count);
+
+	bool isReady() const { return VAO != 0; }
+
+	// bind the textures, or the material arrays and layer, and the per mesh uniforms. Shared by Draw and batched draws
+	void bindMaterial(Shader& shader, bool instanced);
+
+	// replace the full format vertex buffer with posed vertices, same count as uploaded. The buffer is orphaned
+	// and becomes GL_STREAM_DRAW, meant for meshes rewritten every frame
+	void updateVertices(const Vertex* vertexData, size_t numVertices);
+
+	// bounds, bounding sphere and LOD table of the uploaded geometry, a single full level when lods is empty
+	void setGeometry(const Vertex* vertexData, size_t numVertices, size_t numIndices, const std::vector<MeshLod>& levels);
+
+	// index range of the current LOD in the bound element buffer
+	unsigned int drawFirstIndex() const { return firstIndex + lods[currentLod].firstIndex; }
+	unsigned int drawIndexCount() const { return lods[currentLod].indexCount; }
+	size_t indexSize() const { return indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(unsigned int); }
+
 private:
-	unsigned int VBO, EBO;
-	void setupMesh();
+	unsigned int VBO = 0, EBO = 0;	// 0 for meshes packed into a MegaBuffer, the VAO isn't theirs either
+	unsigned int skinVBO = 0;
+	void swap(Mesh& other) noexcept;
+	void setupMesh(const Vertex* vertexData, size_t numVertices, const unsigned int* indexData, size_t numIndices, VertexFormat vertexFormat);
+	void setupCompactSkin(const Vertex* vertexData, size_t numVertices);
 };
 
+// attribute layout of a format, for the GL_ARRAY_BUFFER currently bound to the VAO
+void setupVertexAttributes(VertexFormat format);
+
+// box compact positions are quantized against, flat axes get a scale of 1
+void quantizationBox(const glm::vec3& boundsMin, const glm::vec3& boundsMax, glm::vec3& offset, glm::vec3& scale);
+void vertexBounds(const Vertex* vertices, size_t numVertices, glm::vec3& boundsMin, glm::vec3& boundsMax);
+// sphere around the center of the bounds reaching the farthest vertex, tighter than half the diagonal
+void vertexBoundingSphere(const Vertex* vertices, size_t numVertices, const glm::vec3& boundsMin, const glm::vec3& boundsMax, glm::vec3& center, float& radius);
+
+// true when any vertex carries bone weights
+bool hasBoneWeights(const Vertex* vertices, size_t numVertices);
+
+// quantize vertices into out, true when any of them carries bone weights
+bool encodeCompactVertices(const Vertex* vertices, size_t numVertices, const glm::vec3& offset, const glm::vec3& scale, CompactVertex* out);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,281 @@
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+void VertexCacheStats::add(const VertexCacheStats& other) {
+	triangles += other.triangles;
+	vertices += other.vertices;
+	transformed += other.transformed;
+}
+
+VertexCacheStats analyzeVertexCache(const unsigned int* indices, size_t numIndices, size_t numVertices, unsigned int cacheSize) {
+	VertexCacheStats stats;
+	stats.triangles = numIndices / 3;
+
+	// a vertex is still cached when fewer than cacheSize misses happened since it was loaded
+	std::vector<unsigned int> loadedAt(numVertices, 0);
+	std::vector<bool> referenced(numVertices, false);
+	unsigned int time = cacheSize + 1;
+
+	for (size_t i = 0; i < numIndices; i++) {
+		unsigned int index = indices[i];
+		if (time - loadedAt[index] > cacheSize) {
+			loadedAt[index] = time++;
+			stats.transformed++;
+		}
+		if (!referenced[index]) {
+			referenced[index] = true;
+			stats.vertices++;
+		}
+	}
+	return stats;
+}
+
+// ---- vertex cache ----
+
+#define FORSYTH_CACHE_SIZE 32
+
+static float forsythScore(int cachePosition, unsigned int liveTriangles) {
+	if (liveTriangles == 0) return -1.0f;
+
+	float score = 0.0f;
+	if (cachePosition >= 0) {
+		// the last triangle's vertices score the same so it isn't simply repeated
+		if (cachePosition < 3) score = 0.75f;
+		else score = std::pow(1.0f - float(cachePosition - 3) / (FORSYTH_CACHE_SIZE - 3), 1.5f);
+	}
+
+	// favour vertices with few triangles left so they leave the working set early
+	return score + 2.0f / std::sqrt(float(liveTriangles));
+}
+
+void optimizeVertexCache(std::vector<unsigned int>& indices, size_t numVertices) {
+	size_t numTriangles = indices.size() / 3;
+	if (numTriangles == 0) return;
+
+	// triangles using each vertex, the first liveTriangles[v] entries are the ones not emitted yet
+	std::vector<unsigned int> liveTriangles(numVertices, 0);
+	for (unsigned int index : indices) liveTriangles[index]++;
+
+	std::vector<unsigned int> adjacencyStart(numVertices + 1, 0);
+	for (size_t v = 0; v < numVertices; v++) adjacencyStart[v + 1] = adjacencyStart[v] + liveTriangles[v];
+
+	std::vector<unsigned int> adjacency(indices.size());
+	std::vector<unsigned int> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+	for (size_t t = 0; t < numTriangles; t++) {
+		for (int k = 0; k < 3; k++) adjacency[fill[indices[t * 3 + k]]++] = static_cast<unsigned int>(t);
+	}
+
+	std::vector<int> cachePosition(numVertices, -1);
+	std::vector<float> vertexScore(numVertices);
+	for (size_t v = 0; v < numVertices; v++) vertexScore[v] = forsythScore(-1, liveTriangles[v]);
+
+	std::vector<float> triangleScore(numTriangles);
+	std::vector<bool> emitted(numTriangles, false);
+	int best = 0;
+	for (size_t t = 0; t < numTriangles; t++) {
+		triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+		if (triangleScore[t] > triangleScore[best]) best = static_cast<int>(t);
+	}
+
+	std::vector<unsigned int> output;
+	output.reserve(indices.size());
+	std::vector<unsigned int> cache, nextCache;
+	cache.reserve(FORSYTH_CACHE_SIZE + 3);
+	nextCache.reserve(FORSYTH_CACHE_SIZE + 3);
+	size_t cursor = 0;
+
+	while (output.size() < indices.size()) {
+		// nothing in the cache has triangles left, restart from the first remaining one in input order
+		if (best < 0) {
+			while (emitted[cursor]) cursor++;
+			best = static_cast<int>(cursor);
+		}
+
+		const unsigned int* triangle = &indices[best * 3];
+		output.insert(output.end(), triangle, triangle + 3);
+		emitted[best] = true;
+
+		for (int k = 0; k < 3; k++) {
+			unsigned int v = triangle[k];
+			unsigned int* begin = &adjacency[adjacencyStart[v]];
+			unsigned int* end = begin + liveTriangles[v];
+			std::iter_swap(std::find(begin, end, static_cast<unsigned int>(best)), end - 1);
+			liveTriangles[v]--;
+		}
+
+		// emitted vertices go to the front, the rest keep their order and the tail falls out
+		nextCache.assign(triangle, triangle + 3);
+		for (unsigned int v : cache) {
+			if (v != triangle[0] && v != triangle[1] && v != triangle[2]) nextCache.push_back(v);
+		}
+		for (size_t i = FORSYTH_CACHE_SIZE; i < nextCache.size(); i++) cachePosition[nextCache[i]] = -1;
+		if (nextCache.size() > FORSYTH_CACHE_SIZE) nextCache.resize(FORSYTH_CACHE_SIZE);
+
+		// rescore every vertex that moved, including the evicted ones, and their live triangles
+		for (size_t i = 0; i < nextCache.size(); i++) cachePosition[nextCache[i]] = static_cast<int>(i);
+		auto rescore = [&](unsigned int v) {
+			float score = forsythScore(cachePosition[v], liveTriangles[v]);
+			float delta = score - vertexScore[v];
+			vertexScore[v] = score;
+			for (unsigned int a = 0; a < liveTriangles[v]; a++) triangleScore[adjacency[adjacencyStart[v] + a]] += delta;
+		};
+		for (unsigned int v : cache) {
+			if (cachePosition[v] < 0) rescore(v);
+		}
+		for (unsigned int v : nextCache) rescore(v);
+		cache.swap(nextCache);
+
+		// the next triangle is the best one touching the cache
+		best = -1;
+		float bestScore = -1.0f;
+		for (unsigned int v : cache) {
+			for (unsigned int a = 0; a < liveTriangles[v]; a++) {
+				unsigned int t = adjacency[adjacencyStart[v] + a];
+				if (triangleScore[t] > bestScore) {
+					bestScore = triangleScore[t];
+					best = static_cast<int>(t);
+				}
+			}
+		}
+	}
+
+	indices.swap(output);
+}
+
+// ---- overdraw ----
+
+void optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices, float threshold) {
+	size_t numTriangles = indices.size() / 3;
+	if (numTriangles == 0) return;
+
+	// per triangle misses of the FIFO cache, the cache is reset by jumping the clock
+	std::vector<unsigned int> loadedAt(vertices.size(), 0);
+	unsigned int time = VERTEX_CACHE_SIZE + 1;
+	auto misses = [&](size_t t) {
+		unsigned int count = 0;
+		for (int k = 0; k < 3; k++) {
+			unsigned int index = indices[t * 3 + k];
+			if (time - loadedAt[index] > VERTEX_CACHE_SIZE) {
+				loadedAt[index] = time++;
+				count++;
+			}
+		}
+		return count;
+	};
+
+	// hard boundaries: the cache optimizer started over wherever a triangle misses all three vertices
+	std::vector<size_t> hardClusters(1, 0);
+	for (size_t t = 0; t < numTriangles; t++) {
+		if (misses(t) == 3 && t > 0) hardClusters.push_back(t);
+	}
+	hardClusters.push_back(numTriangles);
+
+	// soft boundaries: cut a hard cluster again once its own ACMR gets close enough to the one of the whole cluster
+	std::vector<size_t> clusters;
+	for (size_t h = 0; h + 1 < hardClusters.size(); h++) {
+		size_t start = hardClusters[h], end = hardClusters[h + 1];
+
+		time += VERTEX_CACHE_SIZE + 1;
+		unsigned int clusterMisses = 0;
+		for (size_t t = start; t < end; t++) clusterMisses += misses(t);
+		float clusterAcmr = float(clusterMisses) / (end - start);
+
+		time += VERTEX_CACHE_SIZE + 1;
+		size_t softStart = start;
+		unsigned int softMisses = 0;
+		clusters.push_back(start);
+		for (size_t t = start; t < end; t++) {
+			softMisses += misses(t);
+			if (t + 1 < end && float(softMisses) / (t + 1 - softStart) <= clusterAcmr * threshold) {
+				clusters.push_back(t + 1);
+				softStart = t + 1;
+				softMisses = 0;
+				time += VERTEX_CACHE_SIZE + 1;
+			}
+		}
+	}
+	clusters.push_back(numTriangles);
+
+	// view independent sort key: how far a cluster faces out of the mesh, those are drawn first to occlude the rest
+	glm::vec3 meshCenter(0.0f);
+	for (const Vertex& vertex : vertices) meshCenter += vertex.Position;
+	if (!vertices.empty()) meshCenter /= float(vertices.size());
+
+	size_t numClusters = clusters.size() - 1;
+	std::vector<float> sortKey(numClusters);
+	for (size_t c = 0; c < numClusters; c++) {
+		glm::vec3 center(0.0f), normal(0.0f);
+		float area = 0.0f;
+		for (size_t t = clusters[c]; t < clusters[c + 1]; t++) {
+			const glm::vec3& p0 = vertices[indices[t * 3]].Position;
+			const glm::vec3& p1 = vertices[indices[t * 3 + 1]].Position;
+			const glm::vec3& p2 = vertices[indices[t * 3 + 2]].Position;
+
+			glm::vec3 faceNormal = glm::cross(p1 - p0, p2 - p0);	// length is twice the area
+			float faceArea = glm::length(faceNormal);
+			center += (p0 + p1 + p2) * (faceArea / 3.0f);
+			normal += faceNormal;
+			area += faceArea;
+		}
+		if (area > 0.0f) center /= area;
+
+		float normalLength = glm::length(normal);
+		sortKey[c] = normalLength > 0.0f ? glm::dot(center - meshCenter, normal / normalLength) : 0.0f;
+	}
+
+	std::vector<size_t> order(numClusters);
+	for (size_t c = 0; c < numClusters; c++) order[c] = c;
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sortKey[a] > sortKey[b]; });
+
+	std::vector<unsigned int> output;
+	output.reserve(indices.size());
+	for (size_t c : order) {
+		output.insert(output.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+	}
+	indices.swap(output);
+}
+
+// ---- vertex fetch ----
+
+void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+	const unsigned int unused = ~0u;
+	std::vector<unsigned int> remap(vertices.size(), unused);
+
+	unsigned int next = 0;
+	for (unsigned int& index : indices) {
+		if (remap[index] == unused) remap[index] = next++;
+		index = remap[index];
+	}
+
+	std::vector<Vertex> reordered(next);
+	for (size_t v = 0; v < vertices.size(); v++) {
+		if (remap[v] != unused) reordered[remap[v]] = vertices[v];
+	}
+	vertices.swap(reordered);
+}
+
+MeshOptimizeReport optimizeMesh(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+	MeshOptimizeReport report;
+	report.before = analyzeVertexCache(indices.data(), indices.size(), vertices.size());
+
+	optimizeVertexCache(indices, vertices.size());
+	optimizeOverdraw(indices, vertices);
+	optimizeVertexFetch(vertices, indices);
+
+	report.after = analyzeVertexCache(indices.data(), indices.size(), vertices.size());
+	return report;
+}
+
+void printOptimizeReport(const std::vector<MeshOptimizeReport>& reports) {
+	MeshOptimizeReport total;
+	for (const MeshOptimizeReport& report : reports) {
+		total.before.add(report.before);
+		total.after.add(report.after);
+	}
+
+	std::cout << "MESH_OPTIMIZER:: " << reports.size() << " meshes, ACMR " << total.before.acmr() << " -> " << total.after.acmr()
+		<< ", ATVR " << total.before.atvr() << " -> " << total.after.atvr() << std::endl;
+}
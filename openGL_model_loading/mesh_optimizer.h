@@ -0,0 +1,45 @@
+#ifndef MESH_OPTIMIZER_H
+#define MESH_OPTIMIZER_H
+
+#include "mesh_data.h"
+
+#include <vector>
+
+// size of the FIFO post-transform cache the statistics are simulated with
+#define VERTEX_CACHE_SIZE 16
+
+// post-transform cache efficiency of an index buffer
+struct VertexCacheStats {
+	size_t triangles = 0;
+	size_t vertices = 0;		// referenced vertices
+	size_t transformed = 0;		// cache misses, each one runs the vertex shader
+
+	float acmr() const { return triangles ? float(transformed) / triangles : 0.0f; }	// 0.5 at best, 3 at worst
+	float atvr() const { return vertices ? float(transformed) / vertices : 0.0f; }		// 1 at best
+
+	void add(const VertexCacheStats& other);
+};
+
+struct MeshOptimizeReport {
+	VertexCacheStats before;
+	VertexCacheStats after;
+};
+
+VertexCacheStats analyzeVertexCache(const unsigned int* indices, size_t numIndices, size_t numVertices, unsigned int cacheSize = VERTEX_CACHE_SIZE);
+
+// reorder triangles for post-transform cache locality (Forsyth's linear speed algorithm)
+void optimizeVertexCache(std::vector<unsigned int>& indices, size_t numVertices);
+
+// split the cache optimized order into clusters and sort them so outward facing ones come first,
+// threshold is how much cluster ACMR may degrade for smaller clusters (Sander et al.)
+void optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices, float threshold = 1.05f);
+
+// renumber the vertices in first use order so the fetches walk the buffer linearly, unused vertices are dropped
+void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+// all three passes in order, CPU only so it can run on the worker pool
+MeshOptimizeReport optimizeMesh(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+
+void printOptimizeReport(const std::vector<MeshOptimizeReport>& reports);
+
+#endif
@@ -0,0 +1,274 @@
+#include "mesh_simplifier.h"
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <queue>
+#include <unordered_map>
+
+// sum of squared distances to a set of area weighted planes, p^T Q p / weight
+struct Quadric {
+	double a2 = 0, ab = 0, ac = 0, ad = 0, b2 = 0, bc = 0, bd = 0, c2 = 0, cd = 0, d2 = 0;
+	double weight = 0;
+
+	void addPlane(const glm::vec3& normal, double d, double area) {
+		double a = normal.x, b = normal.y, c = normal.z;
+		a2 += area * a * a; ab += area * a * b; ac += area * a * c; ad += area * a * d;
+		b2 += area * b * b; bc += area * b * c; bd += area * b * d;
+		c2 += area * c * c; cd += area * c * d;
+		d2 += area * d * d;
+		weight += area;
+	}
+
+	void add(const Quadric& other) {
+		a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+		b2 += other.b2; bc += other.bc; bd += other.bd;
+		c2 += other.c2; cd += other.cd;
+		d2 += other.d2;
+		weight += other.weight;
+	}
+
+	double error(const glm::vec3& p) const {
+		double x = p.x, y = p.y, z = p.z;
+		double sum = a2 * x * x + 2 * ab * x * y + 2 * ac * x * z + 2 * ad * x
+			+ b2 * y * y + 2 * bc * y * z + 2 * bd * y
+			+ c2 * z * z + 2 * cd * z
+			+ d2;
+		return weight > 0 ? std::max(sum / weight, 0.0) : 0.0;
+	}
+};
+
+// collapse of u onto v
+struct Collapse {
+	double cost;
+	unsigned int u, v;
+	unsigned int uVersion, vVersion;
+
+	bool operator>(const Collapse& other) const { return cost > other.cost; }
+};
+
+struct PositionKey {
+	size_t operator()(const glm::vec3& p) const {
+		uint32_t bits[3];
+		std::memcpy(bits, &p.x, sizeof(bits));
+		return (size_t(bits[0]) * 73856093u) ^ (size_t(bits[1]) * 19349663u) ^ (size_t(bits[2]) * 83492791u);
+	}
+};
+
+struct PositionEqual {
+	bool operator()(const glm::vec3& a, const glm::vec3& b) const { return a.x == b.x && a.y == b.y && a.z == b.z; }
+};
+
+std::vector<unsigned int> simplifyMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+	size_t targetIndexCount, float& resultError) {
+	resultError = 0.0f;
+	size_t numVertices = vertices.size();
+	size_t numTriangles = indices.size() / 3;
+	if (indices.size() <= targetIndexCount) return indices;
+
+	// vertices split only by normals or coords share a position, the first of them stands for all
+	std::vector<unsigned int> position(numVertices);
+	std::vector<unsigned int> wedges(numVertices, 0);
+	{
+		std::unordered_map<glm::vec3, unsigned int, PositionKey, PositionEqual> firstAt;
+		for (unsigned int v = 0; v < numVertices; v++) {
+			position[v] = firstAt.emplace(vertices[v].Position, v).first->second;
+			wedges[position[v]]++;
+		}
+	}
+
+	// open borders and seams are locked, so are non manifold edges
+	std::vector<bool> locked(numVertices, false);
+	{
+		std::unordered_map<uint64_t, unsigned int> edgeUse;
+		for (size_t t = 0; t < numTriangles; t++) {
+			for (int k = 0; k < 3; k++) {
+				uint64_t a = position[indices[t * 3 + k]], b = position[indices[t * 3 + (k + 1) % 3]];
+				edgeUse[std::min(a, b) << 32 | std::max(a, b)]++;
+			}
+		}
+		for (const auto& edge : edgeUse) {
+			if (edge.second != 2) {
+				locked[edge.first >> 32] = true;
+				locked[edge.first & 0xffffffffu] = true;
+			}
+		}
+		for (unsigned int v = 0; v < numVertices; v++) {
+			if (wedges[position[v]] > 1) locked[position[v]] = true;
+		}
+	}
+
+	std::vector<unsigned int> triangles(indices);
+	std::vector<bool> alive(numTriangles, true);
+	std::vector<std::vector<unsigned int>> adjacency(numVertices);
+	std::vector<Quadric> quadrics(numVertices);
+	for (unsigned int t = 0; t < numTriangles; t++) {
+		const glm::vec3& p0 = vertices[triangles[t * 3]].Position;
+		const glm::vec3& p1 = vertices[triangles[t * 3 + 1]].Position;
+		const glm::vec3& p2 = vertices[triangles[t * 3 + 2]].Position;
+
+		glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+		float doubleArea = glm::length(normal);
+		if (doubleArea > 0.0f) {
+			normal /= doubleArea;
+			double d = -glm::dot(normal, p0);
+			for (int k = 0; k < 3; k++) quadrics[position[triangles[t * 3 + k]]].addPlane(normal, d, doubleArea * 0.5);
+		}
+		for (int k = 0; k < 3; k++) adjacency[triangles[t * 3 + k]].push_back(t);
+	}
+
+	std::vector<unsigned int> version(numVertices, 0);
+	std::vector<bool> removed(numVertices, false);
+	std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> heap;
+
+	auto push = [&](unsigned int u, unsigned int v) {
+		if (locked[position[u]] || u == v) return;
+		Quadric combined = quadrics[position[u]];
+		combined.add(quadrics[position[v]]);
+		heap.push(Collapse{ combined.error(vertices[v].Position), u, v, version[u], version[v] });
+	};
+
+	for (size_t t = 0; t < numTriangles; t++) {
+		for (int k = 0; k < 3; k++) {
+			unsigned int a = triangles[t * 3 + k], b = triangles[t * 3 + (k + 1) % 3];
+			push(a, b);
+			push(b, a);
+		}
+	}
+
+	std::vector<unsigned int> uNeighbours, vNeighbours;
+	auto neighbours = [&](unsigned int v, std::vector<unsigned int>& out) {
+		out.clear();
+		for (unsigned int t : adjacency[v]) {
+			if (!alive[t]) continue;
+			for (int k = 0; k < 3; k++) {
+				unsigned int w = triangles[t * 3 + k];
+				if (w != v && std::find(out.begin(), out.end(), w) == out.end()) out.push_back(w);
+			}
+		}
+	};
+
+	size_t liveTriangles = numTriangles;
+	double maxCost = 0.0;
+	while (liveTriangles * 3 > targetIndexCount && !heap.empty()) {
+		Collapse collapse = heap.top();
+		heap.pop();
+
+		unsigned int u = collapse.u, v = collapse.v;
+		if (removed[u] || removed[v] || collapse.uVersion != version[u] || collapse.vVersion != version[v]) continue;
+
+		// the edge may be gone, and collapsing must keep the surface manifold: the two vertices may only
+		// share the neighbours opposite to their shared triangles
+		unsigned int shared = 0;
+		for (unsigned int t : adjacency[u]) {
+			if (!alive[t]) continue;
+			if (triangles[t * 3] == v || triangles[t * 3 + 1] == v || triangles[t * 3 + 2] == v) shared++;
+		}
+		if (shared == 0) continue;
+
+		neighbours(u, uNeighbours);
+		neighbours(v, vNeighbours);
+		unsigned int common = 0;
+		for (unsigned int w : uNeighbours) {
+			if (std::find(vNeighbours.begin(), vNeighbours.end(), w) != vNeighbours.end()) common++;
+		}
+		if (common > shared) continue;
+
+		// reject collapses that flip or squash a remaining triangle
+		bool flips = false;
+		for (unsigned int t : adjacency[u]) {
+			if (!alive[t]) continue;
+			const unsigned int* tri = &triangles[t * 3];
+			if (tri[0] == v || tri[1] == v || tri[2] == v) continue;
+
+			glm::vec3 before[3], after[3];
+			for (int k = 0; k < 3; k++) {
+				before[k] = vertices[tri[k]].Position;
+				after[k] = tri[k] == u ? vertices[v].Position : before[k];
+			}
+			glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+			glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+			if (glm::dot(normalBefore, normalAfter) <= 0.0f) {
+				flips = true;
+				break;
+			}
+		}
+		if (flips) continue;
+
+		for (unsigned int t : adjacency[u]) {
+			if (!alive[t]) continue;
+			unsigned int* tri = &triangles[t * 3];
+			if (tri[0] == v || tri[1] == v || tri[2] == v) {
+				alive[t] = false;
+				liveTriangles--;
+				continue;
+			}
+			for (int k = 0; k < 3; k++) {
+				if (tri[k] == u) tri[k] = v;
+			}
+			adjacency[v].push_back(t);
+		}
+		adjacency[u].clear();
+		removed[u] = true;
+
+		quadrics[position[v]].add(quadrics[position[u]]);
+		maxCost = std::max(maxCost, collapse.cost);
+
+		// every collapse involving v is stale now
+		version[v]++;
+		neighbours(v, vNeighbours);
+		for (unsigned int w : vNeighbours) {
+			push(w, v);
+			push(v, w);
+		}
+	}
+
+	std::vector<unsigned int> result;
+	result.reserve(liveTriangles * 3);
+	for (size_t t = 0; t < numTriangles; t++) {
+		if (alive[t]) result.insert(result.end(), triangles.begin() + t * 3, triangles.begin() + t * 3 + 3);
+	}
+
+	resultError = static_cast<float>(std::sqrt(maxCost));
+	return result;
+}
+
+std::vector<MeshLod> buildLodChain(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+	const std::vector<float>& ratios, bool optimizeLevels) {
+	std::vector<MeshLod> lods;
+	size_t fullCount = indices.size();
+
+	MeshLod full;
+	full.firstIndex = 0;
+	full.indexCount = static_cast<unsigned int>(fullCount);
+	full.error = 0.0f;
+	lods.push_back(full);
+
+	// every level starts from the previous one, so their errors add up
+	std::vector<unsigned int> previous(indices);
+	float error = 0.0f;
+	for (float ratio : ratios) {
+		size_t target = static_cast<size_t>(fullCount / 3 * ratio) * 3;
+		if (target >= previous.size()) continue;
+
+		float levelError;
+		std::vector<unsigned int> level = simplifyMesh(vertices, previous, target, levelError);
+
+		// a level that barely shrank isn't worth keeping, locked vertices won't let the next one do better
+		if (level.size() > previous.size() * 9 / 10) break;
+		if (optimizeLevels) optimizeVertexCache(level, vertices.size());
+
+		error += levelError;
+
+		MeshLod lod;
+		lod.firstIndex = static_cast<unsigned int>(indices.size());
+		lod.indexCount = static_cast<unsigned int>(level.size());
+		lod.error = error;
+		lods.push_back(lod);
+
+		indices.insert(indices.end(), level.begin(), level.end());
+		previous.swap(level);
+	}
+	return lods;
+}
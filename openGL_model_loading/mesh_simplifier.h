@@ -0,0 +1,20 @@
+#ifndef MESH_SIMPLIFIER_H
+#define MESH_SIMPLIFIER_H
+
+#include "mesh_data.h"
+
+#include <vector>
+
+// Quadric error edge collapse (Garland & Heckbert) restricted to collapsing a vertex onto one of its
+// neighbours, so only the index buffer changes and every LOD shares the mesh's vertices.
+// Vertices on open borders and attribute seams are locked, the result never opens cracks.
+// resultError is the object space distance the simplified surface may be off by
+std::vector<unsigned int> simplifyMesh(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+	size_t targetIndexCount, float& resultError);
+
+// append one simplified level per ratio (of the full triangle count) to indices, level 0 being the
+// buffer as it is. Levels that barely reduce the previous one end the chain. CPU only
+std::vector<MeshLod> buildLodChain(const std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+	const std::vector<float>& ratios, bool optimizeLevels);
+
+#endif
@@ -1,17 +1,297 @@
 #include "model.h"
+
+#include <cstring>
  
 
-void Model::Draw(Shader& shader) {
+void Model::Draw(Shader& shader, const glm::mat4& model) {
+	Draw(shader, animator, model);
+}
+
+void Model::Draw(Shader& shader, Animator& pose, const glm::mat4& model) {
+	drawMeshes(shader, pose, nullptr, nullptr, model);
+}
+
+void Model::DrawInstanced(Shader& shader, const glm::mat4* transforms, size_t count) {
+	DrawInstanced(shader, animator, transforms, count);
+}
+
+void Model::DrawInstanced(Shader& shader, const std::vector<glm::mat4>& transforms) {
+	DrawInstanced(shader, animator, transforms.data(), transforms.size());
+}
+
+// every instance shares the pose, the transforms go up once for all the meshes
+void Model::DrawInstanced(Shader& shader, Animator& pose, const glm::mat4* transforms, size_t count) {
+	if (count == 0) return;
+	instances.upload(transforms, count);
+	drawMeshes(shader, pose, &instances, nullptr, glm::mat4(1.0f));
+}
+
+void Model::drawMeshes(Shader& shader, Animator& pose, const InstanceBuffer* instanceData, const uint8_t* visible, const glm::mat4& model) {
+	updateTransforms(pose);
+	if (skeleton) {
+		if (usesCpuSkinning()) skinOnCpu(pose, visible);
+		else pose.bindPalette(shader);
+	}
+
+	// meshes under the same node follow each other, the uniform only changes between nodes
+	const glm::mat4* lastTransform = nullptr;
 	for (unsigned int i = 0; i < meshes_list.size(); i++) {
-		meshes_list[i].Draw(shader);
+		if (!meshes_list[i].isReady()) continue; // still streaming in
+		if (visible && !visible[i]) continue;
+		if (megaBuffer && megaBuffer->owns(meshes_list[i])) continue;
+
+		const glm::mat4& transform = meshTransforms[i];
+		if (!lastTransform || std::memcmp(lastTransform, &transform, sizeof(glm::mat4)) != 0) {
+			shader.setMat4(MODEL_UNIFORM, instanceData ? transform : model * transform);
+			lastTransform = &transform;
+		}
+
+		if (instanceData) meshes_list[i].DrawInstanced(shader, *instanceData);
+		else meshes_list[i].Draw(shader);
+	}
+
+	if (megaBuffer) megaBuffer->draw(shader, meshes_list, instanceData, visible, meshTransforms.data(), model);
+}
+
+// pose every CPU skinned mesh into the scratch buffer and overwrite its vertex buffer, culled ones wait
+void Model::skinOnCpu(const Animator& pose, const uint8_t* visible) {
+	const std::vector<glm::mat4>& palette = pose.palette();
+	for (size_t i = 0; i < meshes_list.size(); i++) {
+		Mesh& mesh = meshes_list[i];
+		if (!mesh.cpuSkinned || (visible && !visible[i])) continue;
+		skinVertices(mesh.vertices.data(), mesh.vertices.size(), palette.data(), palette.size(), posedVertices.data());
+		mesh.updateVertices(posedVertices.data(), mesh.vertices.size());
+	}
+}
+
+void Model::setSkeleton(std::shared_ptr<const Skeleton> bones) {
+	if (!bones || !bones->animated()) return;
+
+	skeleton = bones;
+	animator = Animator(skeleton);
+	if (!skeleton->clips.empty()) animator.play(0);
+}
+
+// the skeleton keeps every node of the file, depth first, which is the order the graph needs
+void Model::buildNodes(const Skeleton& hierarchy) {
+	nodes.clear();
+	nodeNames.clear();
+	nodes.reserve(hierarchy.nodes.size());
+	nodeNames.reserve(hierarchy.nodes.size());
+	for (const SkeletonNode& node : hierarchy.nodes) {
+		nodes.addNode(node.parent, node.bindLocal);
+		nodeNames.push_back(node.name);
+	}
+	nodes.update();
+	meshTransforms.clear();
+}
+
+int Model::findNode(const std::string& name) const {
+	for (size_t i = 0; i < nodeNames.size(); i++) {
+		if (nodeNames[i] == name) return static_cast<int>(i);
+	}
+	return -1;
+}
+
+size_t Model::updateTransforms() {
+	return updateTransforms(animator);
+}
+
+size_t Model::updateTransforms(const Animator& pose) {
+	// the animator poses every node of the skeleton, only the locals that differ mark their subtree
+	if (skeleton && pose.currentClip() >= 0) {
+		const std::vector<glm::mat4>& animated = pose.nodeLocals();
+		size_t count = std::min(animated.size(), nodes.size());
+		for (size_t i = 0; i < count; i++) {
+			int node = static_cast<int>(i);
+			if (std::memcmp(&animated[i], &nodes.local(node), sizeof(glm::mat4)) != 0) nodes.setLocal(node, animated[i]);
+		}
+	}
+
+	size_t moved = nodes.update();
+	if (moved == 0 && meshTransforms.size() == meshes_list.size()) return 0;
+
+	// culling spheres and bounds depend on where the meshes are, the packed batches only on which move together
+	updateBounds();
+	if (megaBuffer) megaBuffer->updateTransforms(meshTransforms.data());
+	return moved;
+}
+
+const glm::mat4& Model::meshTransform(size_t mesh) const {
+	static const glm::mat4 identity(1.0f);
+	const Mesh& target = meshes_list[mesh];
+	if (target.skinned || target.cpuSkinned || target.node >= nodes.size()) return identity;
+	return nodes.world(static_cast<int>(target.node));
+}
+
+static float largestScale(const glm::mat4& m) {
+	return std::max(glm::length(glm::vec3(m[0])), std::max(glm::length(glm::vec3(m[1])), glm::length(glm::vec3(m[2]))));
+}
+
+void Model::Draw(Shader& shader, const Camera& camera, const glm::mat4& projection, const glm::mat4& model, float screenHeight) {
+	cull(projection * camera.GetViewMatrix(), model);
+	selectLods(camera, model, screenHeight);
+	drawMeshes(shader, animator, nullptr, meshVisible.data(), model);
+}
+
+void Model::cull(const glm::mat4& viewProjection, const glm::mat4& model) {
+	// node moves, and meshes added to the public meshes_list behind the Model's back, refresh the spheres
+	updateTransforms();
+
+	Frustum frustum = frustumFromMatrix(viewProjection);
+	meshVisible.resize(meshes_list.size());
+
+	// the whole model first, when it is out there is nothing left to test
+	float scale = largestScale(model);
+	glm::vec3 center = glm::vec3(model * glm::vec4(sphereCenter, 1.0f));
+	if (sphereInFrustum(frustum, center, sphereRadius * scale)) cullSpheres(frustum, model, meshSpheres, meshVisible.data());
+	else std::fill(meshVisible.begin(), meshVisible.end(), 0);
+
+	lastCull = CullStats();
+	for (size_t i = 0; i < meshes_list.size(); i++) {
+		const Mesh& mesh = meshes_list[i];
+		if (!mesh.isReady()) continue;
+		// the bounds are the bind pose, an animated mesh can leave them
+		if (mesh.skinned || mesh.cpuSkinned) meshVisible[i] = 1;
+
+		if (meshVisible[i]) lastCull.drawn++;
+		else lastCull.culled++;
+	}
+}
+
+void Model::meshWorldBounds(const glm::mat4& model, std::vector<glm::vec3>& boundsMin, std::vector<glm::vec3>& boundsMax) const {
+	glm::vec3 origin = glm::vec3(model[3]);
+	for (size_t i = 0; i < meshes_list.size(); i++) {
+		const Mesh& mesh = meshes_list[i];
+		glm::vec3 worldMin = origin, worldMax = origin;
+		if (mesh.isReady()) transformBounds(model * meshTransform(i), mesh.boundsMin, mesh.boundsMax, worldMin, worldMax);
+		boundsMin.push_back(worldMin);
+		boundsMax.push_back(worldMax);
+	}
+}
+
+// place the mesh spheres with their node for cullSpheres and grow the model's bounds around them
+void Model::updateBounds() {
+	meshTransforms.resize(meshes_list.size());
+	for (size_t i = 0; i < meshes_list.size(); i++) meshTransforms[i] = meshTransform(i);
+
+	meshSpheres.clear();
+	bool first = true;
+	for (size_t i = 0; i < meshes_list.size(); i++) {
+		const Mesh& mesh = meshes_list[i];
+		const glm::mat4& transform = meshTransforms[i];
+		meshSpheres.push_back(glm::vec3(transform * glm::vec4(mesh.sphereCenter, 1.0f)), mesh.sphereRadius * largestScale(transform));
+		if (!mesh.isReady()) continue;
+
+		glm::vec3 meshMin, meshMax;
+		transformBounds(transform, mesh.boundsMin, mesh.boundsMax, meshMin, meshMax);
+		boundsMin = first ? meshMin : glm::min(boundsMin, meshMin);
+		boundsMax = first ? meshMax : glm::max(boundsMax, meshMax);
+		first = false;
+	}
+
+	// a sphere around the box center that encloses every mesh sphere
+	sphereCenter = (boundsMin + boundsMax) * 0.5f;
+	sphereRadius = 0.0f;
+	for (size_t i = 0; i < meshes_list.size(); i++) {
+		if (!meshes_list[i].isReady()) continue;
+		glm::vec3 center(meshSpheres.x[i], meshSpheres.y[i], meshSpheres.z[i]);
+		sphereRadius = std::max(sphereRadius, glm::length(center - sphereCenter) + meshSpheres.radius[i]);
+	}
+}
+
+void Model::selectLods(const Camera& camera, const glm::mat4& model, float screenHeight) {
+	// world units per pixel at distance 1, the model matrix scales the object space errors
+	float pixelsPerUnit = screenHeight * 0.5f / std::tan(glm::radians(camera.Zoom) * 0.5f);
+
+	for (size_t i = 0; i < meshes_list.size(); i++) {
+		Mesh& mesh = meshes_list[i];
+		if (mesh.lods.size() < 2) continue;
+
+		glm::mat4 world = model * meshTransform(i);
+		float scale = largestScale(world);
+		glm::vec3 center = glm::vec3(world * glm::vec4((mesh.boundsMin + mesh.boundsMax) * 0.5f, 1.0f));
+		float radius = glm::length(mesh.boundsMax - mesh.boundsMin) * 0.5f * scale;
+		float distance = std::max(glm::length(center - camera.Position) - radius, 0.01f);
+
+		// levels are ordered by growing error, keep the last one that still looks the same
+		mesh.currentLod = 0;
+		for (unsigned int level = 1; level < mesh.lods.size(); level++) {
+			float projectedError = mesh.lods[level].error * scale / distance * pixelsPerUnit;
+			if (projectedError > settings.lodPixelError) break;
+			mesh.currentLod = level;
+		}
+	}
+}
+
+unsigned int ModelSettings::processFlags() const {
+	unsigned int flags = optimizeMeshes ? MESH_PROCESS_OPTIMIZED : 0;
+	if (!lodRatios.empty()) {
+		// other ratios build other levels, a hash of them keeps those cache entries apart
+		uint32_t hash = 2166136261u;
+		for (float ratio : lodRatios) hash = (hash ^ static_cast<uint32_t>(ratio * 10000.0f)) * 16777619u;
+		flags |= MESH_PROCESS_LODS | (hash & 0xffff0000u);
+	}
+	return flags;
+}
+
+size_t Model::vertexMemory() const {
+	size_t bytes = 0;
+	for (const Mesh& mesh : meshes_list) bytes += mesh.vertexBytes;
+	return bytes;
+}
+
+size_t Model::indexMemory() const {
+	size_t bytes = 0;
+	for (const Mesh& mesh : meshes_list) bytes += mesh.indexBytes;
+	return bytes;
+}
+
+void Model::printStats() const {
+	unsigned int shortMeshes = 0, intMeshes = 0;
+	for (const Mesh& mesh : meshes_list) {
+		if (!mesh.isReady()) continue;
+		if (mesh.indexType == GL_UNSIGNED_SHORT) shortMeshes++;
+		else intMeshes++;
 	}
+
+	std::cout << "MODEL_STATS:: meshes " << meshes_list.size() << " (16 bit indices " << shortMeshes << ", 32 bit " << intMeshes
+		<< "), vertex memory " << vertexMemory() << " bytes, index memory " << indexMemory() << " bytes" << std::endl;
 }
 
 
+static bool isPackagePath(const std::string& path) {
+	const std::string extension = MODEL_PACKAGE_EXTENSION;
+	return path.size() > extension.size() && path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
 // Create a new Assimp importer for model loading
 void Model::loadModel(std::string const &path) {
+	directory = path.substr(0, path.find_last_of('/'));
+
+	if (isPackagePath(path)) {
+		if (loadPackage(path)) {
+			std::cout << "MODEL LOADED FROM PACKAGE" << std::endl;
+			packMaterialArrays();
+			printStats();
+			TextureCache::shared().printStats();
+			TextureBlockCache::printStats();
+		}
+		return;
+	}
+
+	// skip assimp entirely when an up to date cache entry exists
+	if (settings.useMeshCache && loadCachedModel(path)) {
+		std::cout << "MODEL LOADED FROM CACHE" << std::endl;
+		packMaterialArrays();
+		printStats();
+		TextureCache::shared().printStats();
+		TextureBlockCache::printStats();
+		return;
+	}
+
 	Assimp::Importer importer;
-	const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);  // aiProcess_FlipUVs help inverting the y axis
+	const aiScene* scene = importer.ReadFile(path, MODEL_IMPORT_FLAGS);  // aiProcess_FlipUVs help inverting the y axis
 
 	if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
 		std::cout << "ERROR::ASSIMP::" << importer.GetErrorString() << std::endl;
@@ -19,35 +299,497 @@ void Model::loadModel(std::string const &path) {
 	}
 	else std::cout << "MODEL LOADED" << std::endl;
 
-	directory = path.substr(0, path.find_last_of('/'));
+	// bone names are mapped to palette slots while the meshes are processed, so the skeleton comes first
+	std::shared_ptr<Skeleton> bones = std::make_shared<Skeleton>(buildSkeleton(scene));
+	buildNodes(*bones);
+	setSkeleton(bones);
+
+	// texture decodes run on the pool while the meshes are processed
+	TextureDecodes decodes = startTextureDecodes(scene, directory, textureJobs(true));
+	size_t firstMesh = meshes_list.size();
+	std::vector<MeshData> processed = processNode(scene->mRootNode, scene, decodes, *bones);
+	packMaterialArrays();
+	printStats();
+	TextureCache::shared().printStats();
+	TextureBlockCache::printStats();
+
+	if (settings.useMeshCache && !processed.empty()) {
+		std::vector<const MeshData*> cacheMeshes;
+		for (const MeshData& data : processed) cacheMeshes.push_back(&data);
+		if (MeshCache::write(path, MODEL_IMPORT_FLAGS, cacheMeshes, settings.processFlags())) AnimationCache::write(path, MODEL_IMPORT_FLAGS, *bones);
+	}
+
+	// the meshes were uploaded without a CPU copy, the processed vectors are handed over instead of copied
+	for (size_t i = 0; i < processed.size(); i++) {
+		Mesh& mesh = meshes_list[firstMesh + i];
+		if (keepsGeometry(mesh)) mesh.keepGeometry(std::move(processed[i].vertices), std::move(processed[i].indices));
+	}
+}
+
+// rebuild the meshes from a mapped cache entry, vertex and index data go to the GPU straight from the mapped pages
+bool Model::loadCachedModel(std::string const& path) {
+	MeshCache cache;
+	if (!cache.open(path, MODEL_IMPORT_FLAGS, settings.processFlags())) return false;
+
+	// the skeleton is cached next to the meshes, without it the entry is incomplete
+	std::shared_ptr<Skeleton> bones = std::make_shared<Skeleton>();
+	if (!AnimationCache::read(path, MODEL_IMPORT_FLAGS, *bones)) return false;
+	buildNodes(*bones);
+	setSkeleton(bones);
+
+	// start every texture decode first so they overlap with the geometry uploads
+	std::vector<CachedMeshView> views;
+	TextureDecodes decodes;
+	TextureJobs jobs = textureJobs(true);
+	for (unsigned int i = 0; i < cache.meshCount(); i++) {
+		views.push_back(cache.mesh(i));
+		attachTextureDecodes(views.back().textures, directory, decodes, jobs);
+	}
+
+	if (settings.packMeshes) beginPacking(cacheTotals(cache));
+
+	meshes_list.reserve(views.size());
+	for (const CachedMeshView& view : views) {
+		std::vector<Texture> textures;
+		for (unsigned int t = 0; t < view.textures.size(); t++) {
+			textures.push_back(loadTexture(view.textures[t]));
+		}
+		meshes_list.push_back(setupMeshView(view, std::move(textures)));
+	}
+	return true;
+}
+
+// a cooked package needs neither assimp nor image decoding: geometry goes to the GPU from the mapped
+// streams and every texture from its stored mip chain
+bool Model::loadPackage(std::string const& path) {
+	ModelPackage package;
+	if (!package.open(path)) {
+		std::cout << "ERROR::MODEL::PACKAGE_NOT_LOADED: " << path << std::endl;
+		return false;
+	}
+
+	std::shared_ptr<Skeleton> bones = std::make_shared<Skeleton>();
+	if (!AnimationCache::deserialize(package.section<unsigned char>(PACKAGE_SKELETON), package.bytes(PACKAGE_SKELETON), *bones)) {
+		std::cout << "ERROR::MODEL::PACKAGE_SKELETON_CORRUPT: " << path << std::endl;
+		return false;
+	}
+	buildNodes(*bones);
+	setSkeleton(bones);
+
+	if (settings.packMeshes) beginPacking(packageTotals(package));
+
+	const PackageMesh* entries = package.section<PackageMesh>(PACKAGE_MESHES);
+	const PackageMeshTexture* references = package.section<PackageMeshTexture>(PACKAGE_MESH_TEXTURES);
+	meshes_list.reserve(package.count(PACKAGE_MESHES));
+	for (unsigned int i = 0; i < package.count(PACKAGE_MESHES); i++) {
+		std::vector<Texture> textures;
+		for (unsigned int t = 0; t < entries[i].numTextures; t++) {
+			const PackageMeshTexture& reference = references[entries[i].firstTexture + t];
+			TextureType type = TEXTURE_DIFFUSE;	// the name was checked when the package was opened
+			textureTypeFromName(package.string(reference.type), type);
+			textures.push_back(loadPackageTexture(package, reference.texture, type));
+		}
+		meshes_list.push_back(setupMeshView(package.mesh(i), std::move(textures)));
+	}
+	return true;
+}
+
+// upload geometry that lives in a mapped file, only CPU skinned meshes get a copy of it
+Mesh Model::setupMeshView(const CachedMeshView& view, std::vector<Texture> textures) {
+	Mesh mesh;
+	if (usesCpuSkinning() && hasBoneWeights(view.vertices, view.numVertices)) {
+		mesh = setupCpuSkinnedMesh(view.vertices, view.numVertices, view.indices, view.numIndices, std::move(textures), view.lods);
+		mesh.keepGeometry(std::vector<Vertex>(view.vertices, view.vertices + view.numVertices),
+			std::vector<unsigned int>(view.indices, view.indices + view.numIndices));
+	}
+	else if (megaBuffer && megaBuffer->canPack(view.vertices, view.numVertices)) {
+		mesh = megaBuffer->append(view.vertices, view.numVertices, view.indices, view.numIndices, std::move(textures), view.lods);
+	}
+	else mesh = Mesh(view.vertices, view.numVertices, view.indices, view.numIndices, std::move(textures), settings.vertexFormat, view.lods);
+
+	mesh.node = view.node;
+	return mesh;
+}
+
+Model Model::LoadAsync(std::string const& path, const ModelSettings& modelSettings) {
+	Model model(modelSettings);
+	if (isPackagePath(path)) {
+		model.loadModel(path);
+		model.updateBounds();
+		return model;
+	}
+
+	model.directory = path.substr(0, path.find_last_of('/'));
+	model.asyncLoad = std::make_shared<AsyncLoadState>();
+
+	// the GL extensions are only queried here, the background half runs without a context
+	std::shared_ptr<AsyncLoadState> state = model.asyncLoad;
+	TextureJobs jobs = model.textureJobs(false);
+	ThreadPool::shared().submit([state, path, modelSettings, jobs]() { runAsyncLoad(state, path, modelSettings, jobs); });
+	return model;
+}
+
+// background half of LoadAsync, pushes every mesh to the queue as soon as it is processed.
+// Meshes are processed with parallelFor so this task also works on them instead of blocking a worker
+void Model::runAsyncLoad(std::shared_ptr<AsyncLoadState> state, std::string path, ModelSettings settings, TextureJobs jobs) {
+	AsyncMeshResult done;
+	std::string directory = path.substr(0, path.find_last_of('/'));
+
+	MeshCache cache;
+	std::shared_ptr<Skeleton> bones = std::make_shared<Skeleton>();
+	if (settings.useMeshCache && cache.open(path, MODEL_IMPORT_FLAGS, settings.processFlags()) && AnimationCache::read(path, MODEL_IMPORT_FLAGS, *bones)) {
+		unsigned int total = cache.meshCount();
+		state->totals = cacheTotals(cache);
+		state->skeleton = bones;
+
+		TextureDecodes decodes;
+		for (unsigned int i = 0; i < total; i++) {
+			std::vector<TextureRef> textures = cache.mesh(i).textures;
+			attachTextureDecodes(textures, directory, decodes, jobs);
+		}
+
+		ThreadPool::shared().parallelFor(total, [&](size_t i) {
+			CachedMeshView view = cache.mesh(static_cast<unsigned int>(i));
+
+			std::shared_ptr<MeshData> data = std::make_shared<MeshData>();
+			data->vertices.assign(view.vertices, view.vertices + view.numVertices);
+			data->indices.assign(view.indices, view.indices + view.numIndices);
+			data->textures = view.textures;
+			data->lods = view.lods;
+			data->node = view.node;
+			for (TextureRef& texture : data->textures) {
+				const TextureDecode& decode = decodes.at(textureDecodeKey(texture.path, texture.type));
+				texture.image = decode.image;
+				texture.compressed = decode.compressed;
+			}
+
+			AsyncMeshResult result;
+			result.slot = static_cast<int>(i);
+			result.total = total;
+			result.data = data;
+			state->completed.push(result);
+		});
+
+		done.total = total;
+		state->completed.push(done);
+		return;
+	}
+
+	Assimp::Importer importer;
+	const aiScene* scene = importer.ReadFile(path, MODEL_IMPORT_FLAGS);
+
+	if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
+		std::cout << "ERROR::ASSIMP::" << importer.GetErrorString() << std::endl;
+		done.failed = true;
+		state->completed.push(done);
+		return;
+	}
 
-	processNode(scene->mRootNode, scene);
+	TextureDecodes decodes = startTextureDecodes(scene, directory, jobs);
+
+	*bones = buildSkeleton(scene);
+	state->skeleton = bones;
+
+	std::vector<aiMesh*> sceneMeshes;
+	std::vector<unsigned int> meshNodes;
+	collectMeshes(scene->mRootNode, scene, sceneMeshes, meshNodes);
+	unsigned int total = static_cast<unsigned int>(sceneMeshes.size());
+	state->totals = sceneTotals(sceneMeshes);
+
+	std::vector<std::shared_ptr<MeshData>> processed(total);
+	std::vector<MeshOptimizeReport> reports(settings.optimizeMeshes ? total : 0);
+	ThreadPool::shared().parallelFor(total, [&](size_t i) {
+		processed[i] = std::make_shared<MeshData>(processMesh(sceneMeshes[i], scene, decodes, *bones));
+		processed[i]->node = meshNodes[i];
+		postProcessMesh(*processed[i], settings, settings.optimizeMeshes ? &reports[i] : nullptr);
+
+		AsyncMeshResult result;
+		result.slot = static_cast<int>(i);
+		result.total = total;
+		result.data = processed[i];
+		state->completed.push(result);
+	});
+
+	if (settings.optimizeMeshes) printOptimizeReport(reports);
+
+	// the GL thread only reads the shared MeshData, writing the cache from here is safe
+	if (settings.useMeshCache && total > 0) {
+		std::vector<const MeshData*> cacheMeshes;
+		for (const std::shared_ptr<MeshData>& data : processed) cacheMeshes.push_back(data.get());
+		if (MeshCache::write(path, MODEL_IMPORT_FLAGS, cacheMeshes, settings.processFlags())) AnimationCache::write(path, MODEL_IMPORT_FLAGS, *bones);
+	}
+
+	done.total = total;
+	state->completed.push(done);
+}
+
+bool Model::importMeshes(const std::string& path, const ModelSettings& settings, std::vector<MeshData>& meshes, Skeleton& skeleton) {
+	Assimp::Importer importer;
+	const aiScene* scene = importer.ReadFile(path, MODEL_IMPORT_FLAGS);
+
+	if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
+		std::cout << "ERROR::ASSIMP::" << importer.GetErrorString() << std::endl;
+		return false;
+	}
+
+	skeleton = buildSkeleton(scene);
+
+	std::vector<aiMesh*> sceneMeshes;
+	std::vector<unsigned int> meshNodes;
+	collectMeshes(scene->mRootNode, scene, sceneMeshes, meshNodes);
+
+	TextureDecodes decodes;
+	meshes.clear();
+	meshes.resize(sceneMeshes.size());
+	std::vector<MeshOptimizeReport> reports(settings.optimizeMeshes ? sceneMeshes.size() : 0);
+	ThreadPool::shared().parallelFor(sceneMeshes.size(), [&](size_t i) {
+		meshes[i] = processMesh(sceneMeshes[i], scene, decodes, skeleton);
+		meshes[i].node = meshNodes[i];
+		postProcessMesh(meshes[i], settings, settings.optimizeMeshes ? &reports[i] : nullptr);
+	});
+
+	if (settings.optimizeMeshes) printOptimizeReport(reports);
+	return true;
+}
+
+void Model::pollAsyncLoad(unsigned int maxUploads) {
+	if (!asyncLoad) return;
+
+	AsyncMeshResult result;
+	unsigned int uploads = 0;
+	while (uploads < maxUploads && asyncLoad->completed.pop(result)) {
+		// placeholders are skipped by Draw until their slot is uploaded
+		if (meshes_list.size() < result.total) meshes_list.resize(result.total);
+		if (nodes.empty() && asyncLoad->skeleton) {
+			buildNodes(*asyncLoad->skeleton);
+			setSkeleton(asyncLoad->skeleton);
+		}
+
+		if (result.slot < 0) {
+			if (result.failed) std::cout << "ERROR::MODEL::ASYNC_LOAD_FAILED" << std::endl;
+			else std::cout << "MODEL LOADED" << std::endl;
+			packMaterialArrays();
+			printStats();
+			TextureCache::shared().printStats();
+			TextureBlockCache::printStats();
+			asyncLoad.reset();
+			updateBounds();
+			return;
+		}
+
+		if (settings.packMeshes && !megaBuffer) beginPacking(asyncLoad->totals);
+		// the loader may still be writing the cache from the shared data, so it is copied, not moved
+		Mesh& mesh = meshes_list[result.slot];
+		mesh = setupMeshData(*result.data);
+		if (keepsGeometry(mesh)) mesh.keepGeometry(std::vector<Vertex>(result.data->vertices), std::vector<unsigned int>(result.data->indices));
+		uploads++;
+	}
+	if (uploads > 0) updateBounds();
 }
 
-// retrieve Meshes from nodes hierarchy to send to processMesh 
+// retrieve Meshes from nodes hierarchy, process them on the worker pool and upload them in node order
 
-void Model::processNode(aiNode* node, const aiScene* scene) {
-	// process current node's list of mesh
+std::vector<MeshData> Model::processNode(aiNode* node, const aiScene* scene, const TextureDecodes& decodes, const Skeleton& bones) {
+	std::vector<aiMesh*> sceneMeshes;
+	std::vector<unsigned int> meshNodes;
+	collectMeshes(node, scene, sceneMeshes, meshNodes);
+	if (settings.packMeshes && !megaBuffer) beginPacking(sceneTotals(sceneMeshes));
+
+	// CPU side processing of every mesh is independent, fan it out
+	ThreadPool& pool = ThreadPool::shared();
+	std::vector<std::future<MeshData>> pending;
+	pending.reserve(sceneMeshes.size());
+	std::vector<MeshOptimizeReport> reports(settings.optimizeMeshes ? sceneMeshes.size() : 0);
+	for (size_t i = 0; i < sceneMeshes.size(); i++) {
+		aiMesh* mesh = sceneMeshes[i];
+		unsigned int meshNode = meshNodes[i];
+		MeshOptimizeReport* report = settings.optimizeMeshes ? &reports[i] : nullptr;
+		const ModelSettings& modelSettings = settings;
+		pending.push_back(pool.submit([mesh, meshNode, scene, &decodes, &bones, &modelSettings, report]() {
+			MeshData data = processMesh(mesh, scene, decodes, bones);
+			data.node = meshNode;
+			postProcessMesh(data, modelSettings, report);
+			return data;
+		}));
+	}
+
+	// GL uploads stay on this thread, waiting in order keeps meshes_list deterministic
+	// while later meshes are still being processed
+	std::vector<MeshData> processed(pending.size());
+	meshes_list.reserve(meshes_list.size() + pending.size());
+	for (unsigned int i = 0; i < pending.size(); i++) {
+		processed[i] = pending[i].get();
+		meshes_list.push_back(setupMeshData(processed[i]));
+	}
+
+	if (settings.optimizeMeshes) printOptimizeReport(reports);
+	return processed;
+}
+
+// depth first walk of the nodes, same order the meshes used to be processed in and the one
+// buildSkeleton numbers the nodes in, which is what meshNodes holds for every mesh
+static void collectNodeMeshes(aiNode* node, const aiScene* scene, unsigned int& nodeIndex, std::vector<aiMesh*>& sceneMeshes, std::vector<unsigned int>& meshNodes) {
+	unsigned int index = nodeIndex++;
 	for (unsigned int i = 0; i < node->mNumMeshes; i++) {
-		aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-		meshes_list.push_back(processMesh(mesh, scene));
+		sceneMeshes.push_back(scene->mMeshes[node->mMeshes[i]]);
+		meshNodes.push_back(index);
 	}
 
 	for (unsigned int i = 0; i < node->mNumChildren; i++) {
-		processNode(node->mChildren[i], scene);
+		collectNodeMeshes(node->mChildren[i], scene, nodeIndex, sceneMeshes, meshNodes);
+	}
+}
+
+void Model::collectMeshes(aiNode* node, const aiScene* scene, std::vector<aiMesh*>& sceneMeshes, std::vector<unsigned int>& meshNodes) {
+	unsigned int nodeIndex = 0;
+	collectNodeMeshes(node, scene, nodeIndex, sceneMeshes, meshNodes);
+}
+
+// load the referenced textures and upload the geometry, needs the GL context. No CPU copy of
+// the geometry is made, keepsGeometry() tells whether the caller has to hand one over
+Mesh Model::setupMeshData(const MeshData& data) {
+	std::vector<Texture> textures;
+	for (unsigned int i = 0; i < data.textures.size(); i++) {
+		textures.push_back(loadTexture(data.textures[i]));
+	}
+
+	Mesh mesh;
+	if (usesCpuSkinning() && hasBoneWeights(data.vertices.data(), data.vertices.size())) {
+		mesh = setupCpuSkinnedMesh(data.vertices.data(), data.vertices.size(), data.indices.data(), data.indices.size(), std::move(textures), data.lods);
+	}
+	else if (megaBuffer && megaBuffer->canPack(data.vertices.data(), data.vertices.size())) {
+		mesh = megaBuffer->append(data.vertices.data(), data.vertices.size(), data.indices.data(), data.indices.size(), std::move(textures), data.lods);
+	}
+	else mesh = Mesh(data.vertices.data(), data.vertices.size(), data.indices.data(), data.indices.size(), std::move(textures), settings.vertexFormat, data.lods);
+
+	mesh.node = data.node;
+	return mesh;
+}
+
+// CPU copies stay with CPU skinned meshes, which pose from them, and with meshes owning their buffers unless released
+bool Model::keepsGeometry(const Mesh& mesh) const {
+	if (mesh.cpuSkinned) return true;
+	return !settings.releaseCpuGeometry && !(megaBuffer && megaBuffer->owns(mesh));
+}
+
+// CPU skinned meshes get a full format vertex buffer of their own to pose into, the caller hands them their bind pose
+Mesh Model::setupCpuSkinnedMesh(const Vertex* vertices, size_t numVertices, const unsigned int* indices, size_t numIndices, std::vector<Texture> textures,
+	const std::vector<MeshLod>& lods) {
+	Mesh mesh(vertices, numVertices, indices, numIndices, std::move(textures), VERTEX_FORMAT_FULL, lods);
+	mesh.skinned = false;
+	mesh.cpuSkinned = true;
+	mesh.updateVertices(vertices, numVertices);	// stream storage from the start, the pose rewrites it every frame
+	if (posedVertices.size() < numVertices) posedVertices.resize(numVertices);
+	return mesh;
+}
+
+// the shared buffers are sized for the whole model up front, compact positions are quantized against its bounds
+void Model::beginPacking(const MeshTotals& totals) {
+	megaBuffer.reset(new MegaBuffer(settings.vertexFormat, totals.boundsMin, totals.boundsMax));
+	megaBuffer->reserve(totals.numVertices, totals.numIndices);
+}
+
+// once every mesh is up: materials sharing a shape go into texture arrays, and the plain textures
+// only packed meshes used are given back to the cache
+void Model::packMaterialArrays() {
+	if (!settings.packMaterials || materialArrays) return;
+
+	materialArrays.reset(new MaterialArrays());
+	materialArrays->build(meshes_list);
+	if (megaBuffer) megaBuffer->setMaterialLayers(meshes_list);
+
+	std::unordered_set<unsigned int> stillBound;
+	for (const Mesh& mesh : meshes_list) {
+		if (mesh.materialGroup) continue;
+		for (const Texture& texture : mesh.textures) stillBound.insert(texture.id);
+	}
+
+	// id 0 marks a texture the arrays hold now, packed meshes never bind it
+	for (size_t i = 0; i < textures_loaded.size(); i++) {
+		if (stillBound.count(textures_loaded[i].id)) continue;
+		texture_handles[i].reset();
+		textures_loaded[i].id = 0;
+	}
+	for (Mesh& mesh : meshes_list) {
+		if (!mesh.materialGroup) continue;
+		for (Texture& texture : mesh.textures) texture.id = 0;
+	}
+	materialArrays->printStats();
+}
+
+MeshTotals Model::sceneTotals(const std::vector<aiMesh*>& sceneMeshes) {
+	MeshTotals totals;
+	bool first = true;
+	for (aiMesh* mesh : sceneMeshes) {
+		totals.numVertices += mesh->mNumVertices;
+		for (unsigned int i = 0; i < mesh->mNumFaces; i++) totals.numIndices += mesh->mFaces[i].mNumIndices;
+
+		for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
+			glm::vec3 position(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+			totals.boundsMin = first ? position : glm::min(totals.boundsMin, position);
+			totals.boundsMax = first ? position : glm::max(totals.boundsMax, position);
+			first = false;
+		}
+	}
+	return totals;
+}
+
+MeshTotals Model::cacheTotals(const MeshCache& cache) {
+	MeshTotals totals;
+	for (unsigned int i = 0; i < cache.meshCount(); i++) {
+		CachedMeshView view = cache.mesh(i);
+		if (view.numVertices == 0) continue;
+
+		glm::vec3 boundsMin, boundsMax;
+		vertexBounds(view.vertices, view.numVertices, boundsMin, boundsMax);
+		totals.boundsMin = totals.numVertices == 0 ? boundsMin : glm::min(totals.boundsMin, boundsMin);
+		totals.boundsMax = totals.numVertices == 0 ? boundsMax : glm::max(totals.boundsMax, boundsMax);
+
+		totals.numVertices += view.numVertices;
+		totals.numIndices += view.numIndices;
+	}
+	return totals;
+}
+
+MeshTotals Model::packageTotals(const ModelPackage& package) {
+	MeshTotals totals;
+	const PackageMesh* entries = package.section<PackageMesh>(PACKAGE_MESHES);
+	const Vertex* vertices = package.section<Vertex>(PACKAGE_VERTICES);
+	for (unsigned int i = 0; i < package.count(PACKAGE_MESHES); i++) {
+		if (entries[i].numVertices == 0) continue;
+
+		glm::vec3 boundsMin, boundsMax;
+		vertexBounds(vertices + entries[i].firstVertex, entries[i].numVertices, boundsMin, boundsMax);
+		totals.boundsMin = totals.numVertices == 0 ? boundsMin : glm::min(totals.boundsMin, boundsMin);
+		totals.boundsMax = totals.numVertices == 0 ? boundsMax : glm::max(totals.boundsMax, boundsMax);
+
+		totals.numVertices += entries[i].numVertices;
+		totals.numIndices += entries[i].numIndices;
 	}
+	return totals;
 }
 
 
-// process the mesh indicated by index from processNode, organize the data into a Mesh object
-Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene) {
+// process the mesh indicated by index from processNode, organize the data into a MeshData object.
+// Runs on worker threads so it must not touch GL or any Model state
+MeshData Model::processMesh(aiMesh* mesh, const aiScene* scene, const TextureDecodes& decodes, const Skeleton& bones) {
 	std::vector<Vertex> vertices;
 	std::vector<unsigned int> indices;
-	std::vector<Texture> textures;
+	std::vector<TextureRef> textures;
+
+	// sized once, the meshes are triangulated on import
+	vertices.reserve(mesh->mNumVertices);
+	indices.reserve(static_cast<size_t>(mesh->mNumFaces) * 3);
 
 	for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
 		Vertex vertex;
 
+		// no bone influences until the mesh's bones fill them in, the compact format checks the weights
+		for (int j = 0; j < MAX_BONE_INFLUENCE; j++) {
+			vertex.m_BoneIDs[j] = -1;
+			vertex.m_Weights[j] = 0.0f;
+		}
+
 		//process vertices position
 		glm::vec3 vector; // placeholder vector since assimp has its own type
 		vector.x = mesh->mVertices[i].x;
@@ -62,6 +804,7 @@ Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene) {
 			vector.z = mesh->mNormals[i].z;
 			vertex.Normal = vector;
 		}
+		else vertex.Normal = glm::vec3(0.0f);
 
 
 		// process vertices Texture coordinates
@@ -85,10 +828,34 @@ Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene) {
 		}
 		else {
 			vertex.TexCoords = glm::vec2(0.0f, 0.0f);
+			vertex.Tangent = glm::vec3(0.0f);
+			vertex.Bitangent = glm::vec3(0.0f);
 		}
 		vertices.push_back(vertex);
 	}
 
+	// process bone weights, the skeleton was built before the workers started and maps names to palette slots
+	for (unsigned int b = 0; b < mesh->mNumBones; b++) {
+		const aiBone* bone = mesh->mBones[b];
+		auto found = bones.boneIndex.find(bone->mName.C_Str());
+		if (found == bones.boneIndex.end()) continue;
+
+		for (unsigned int w = 0; w < bone->mNumWeights; w++) {
+			const aiVertexWeight& influence = bone->mWeights[w];
+			if (influence.mVertexId < vertices.size()) addBoneWeight(vertices[influence.mVertexId], found->second, influence.mWeight);
+		}
+	}
+
+	// influences past MAX_BONE_INFLUENCE were dropped, the kept ones have to add up to 1 again
+	if (mesh->mNumBones > 0) {
+		for (Vertex& vertex : vertices) {
+			float total = 0.0f;
+			for (int j = 0; j < MAX_BONE_INFLUENCE; j++) total += vertex.m_Weights[j];
+			if (total <= 0.0f) continue;
+			for (int j = 0; j < MAX_BONE_INFLUENCE; j++) vertex.m_Weights[j] /= total;
+		}
+	}
+
 	// process indices
 	for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
 		aiFace face = mesh->mFaces[i];
@@ -101,92 +868,297 @@ Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene) {
 	if (mesh->mMaterialIndex >= 0) {
 		aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
 
-		std::vector<Texture> diffuseMaps = loadMaterialTextures(material, aiTextureType_DIFFUSE, "texture_diffuse");
+		std::vector<TextureRef> diffuseMaps = materialTextureRefs(material, aiTextureType_DIFFUSE, TEXTURE_DIFFUSE, decodes);
 		textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
 
-		std::vector<Texture> specularMaps = loadMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular");
+		std::vector<TextureRef> specularMaps = materialTextureRefs(material, aiTextureType_SPECULAR, TEXTURE_SPECULAR, decodes);
 		textures.insert(textures.end(), specularMaps.begin(), specularMaps.end());
 
 		// 3. normal maps
-		std::vector<Texture> normalMaps = loadMaterialTextures(material, aiTextureType_HEIGHT, "texture_normal");
+		std::vector<TextureRef> normalMaps = materialTextureRefs(material, aiTextureType_HEIGHT, TEXTURE_NORMAL, decodes);
 		textures.insert(textures.end(), normalMaps.begin(), normalMaps.end());
 		// 4. height maps
-		std::vector<Texture> heightMaps = loadMaterialTextures(material, aiTextureType_AMBIENT, "texture_height");
+		std::vector<TextureRef> heightMaps = materialTextureRefs(material, aiTextureType_AMBIENT, TEXTURE_HEIGHT, decodes);
 		textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
 
 	}
 
-	return Mesh(vertices, indices, textures);
+	MeshData data;
+	data.vertices = std::move(vertices);
+	data.indices = std::move(indices);
+	data.textures = std::move(textures);
+	return data;
 }
 
-std::vector<Texture> Model::loadMaterialTextures(aiMaterial* mat, aiTextureType type, std::string typeName) {
-	std::vector<Texture> textures;
+// first free influence slot, or the weakest one when the new weight beats it
+void Model::addBoneWeight(Vertex& vertex, int bone, float weight) {
+	if (weight <= 0.0f) return;
+
+	int slot = 0;
+	for (int j = 0; j < MAX_BONE_INFLUENCE; j++) {
+		if (vertex.m_BoneIDs[j] < 0) {
+			slot = j;
+			break;
+		}
+		if (vertex.m_Weights[j] < vertex.m_Weights[slot]) slot = j;
+	}
+	if (vertex.m_BoneIDs[slot] >= 0 && vertex.m_Weights[slot] >= weight) return;
+
+	vertex.m_BoneIDs[slot] = bone;
+	vertex.m_Weights[slot] = weight;
+}
+
+// optional steps after processMesh, the results are what gets cached
+void Model::postProcessMesh(MeshData& data, const ModelSettings& settings, MeshOptimizeReport* report) {
+	if (settings.optimizeMeshes) {
+		MeshOptimizeReport optimized = optimizeMesh(data.vertices, data.indices);
+		if (report) *report = optimized;
+	}
+	if (!settings.lodRatios.empty()) {
+		data.lods = buildLodChain(data.vertices, data.indices, settings.lodRatios, settings.optimizeMeshes);
+	}
+}
+
+// what a file is uploaded as is part of its key in the caches: RGBA8 and BC1, or a color map and a BC5 normal map
+// of the same file, are different GL textures
+static std::string textureVariant(const TextureJobs& jobs, TextureType type) {
+	if (!jobs.compress) return "#rgba8";
+	std::string variant = type == TEXTURE_NORMAL ? "#normal" : "#color";
+	variant += "#q" + std::to_string(static_cast<unsigned int>(jobs.encoding.quality));
+	if (jobs.encoding.allowBC7) variant += "#bc7";
+	return variant;
+}
+
+// cooked textures keep the block format they were cooked to
+static std::string packageTextureVariant(const PackageTexture& stored) {
+	return "#pkg" + std::to_string(stored.format);
+}
+
+// only reads the material, the textures themselves are loaded later on the GL thread
+std::vector<TextureRef> Model::materialTextureRefs(aiMaterial* mat, aiTextureType type, TextureType typeName, const TextureDecodes& decodes) {
+	std::vector<TextureRef> textures;
 
 	for (unsigned int i = 0; i < mat->GetTextureCount(type); i++) {
 		aiString str;
 		mat->GetTexture(type, i, &str);
-		bool skip = false;
 
-		for (unsigned int j = 0; j < textures_loaded.size(); j++) {
-			if (std::strcmp(textures_loaded[j].path.data(), str.C_Str()) == 0) {
-				textures.push_back(textures_loaded[j]);
-				skip = true; // skip if a texture witht he same filepath is already loaded
-				break;
-			}
-		}
+		TextureRef texture;
+		texture.type = typeName;
+		texture.path = str.C_Str();
 
-		if (!skip) {
-			Texture texture;
-			texture.id = TextureFromFile(str.C_Str(), this->directory);
-			texture.type = typeName;
-			texture.path = str.C_Str();
-			textures.push_back(texture);
-			textures_loaded.push_back(texture);
+		auto decode = decodes.find(textureDecodeKey(texture.path, typeName));
+		if (decode != decodes.end()) {
+			texture.image = decode->second.image;
+			texture.compressed = decode->second.compressed;
 		}
+		textures.push_back(texture);
 	}
 
 	return textures;
 }
 
-unsigned int Model::TextureFromFile(const char* path, const std::string& directory, bool gamma) {
-	std::string filename = std::string(path);
+// material texture slots read from every aiMaterial, same as the ones processMesh collects
+struct MaterialTextureSlot {
+	aiTextureType slot;
+	TextureType type;
+};
+static const MaterialTextureSlot MATERIAL_TEXTURE_SLOTS[] = {
+	{ aiTextureType_DIFFUSE, TEXTURE_DIFFUSE }, { aiTextureType_SPECULAR, TEXTURE_SPECULAR },
+	{ aiTextureType_HEIGHT, TEXTURE_NORMAL }, { aiTextureType_AMBIENT, TEXTURE_HEIGHT }
+};
 
-	filename = directory + '/' + filename;
+TextureJobs Model::textureJobs(bool skipCached) const {
+	TextureJobs jobs;
+	jobs.skipCached = skipCached;
+	jobs.compress = settings.compressTextures;
+	jobs.encoding.quality = settings.textureQuality;
+	jobs.encoding.allowBC7 = settings.compressTextures && glExtensions().textureCompressionBPTC;
+	jobs.useCache = settings.useMeshCache;
+	return jobs;
+}
 
-	unsigned int textureID;
-	glGenTextures(1, &textureID);
+TextureDecodes Model::startTextureDecodes(const aiScene* scene, const std::string& directory, const TextureJobs& jobs) {
+	TextureDecodes decodes;
 
-	// load images with stbi
-	int width, height, nrComponents;
-	unsigned char* data = stbi_load(filename.c_str(), &width, &height, &nrComponents, 0);
+	for (unsigned int m = 0; m < scene->mNumMaterials; m++) {
+		aiMaterial* material = scene->mMaterials[m];
 
+		for (const MaterialTextureSlot& slot : MATERIAL_TEXTURE_SLOTS) {
+			for (unsigned int i = 0; i < material->GetTextureCount(slot.slot); i++) {
+				aiString str;
+				material->GetTexture(slot.slot, i, &str);
+				queueTextureDecode(str.C_Str(), slot.type, directory, decodes, jobs);
+			}
+		}
+	}
+	return decodes;
+}
+
+void Model::attachTextureDecodes(std::vector<TextureRef>& textures, const std::string& directory, TextureDecodes& decodes, const TextureJobs& jobs) {
+	for (TextureRef& texture : textures) {
+		queueTextureDecode(texture.path, texture.type, directory, decodes, jobs);
+		const TextureDecode& decode = decodes[textureDecodeKey(texture.path, texture.type)];
+		texture.image = decode.image;
+		texture.compressed = decode.compressed;
+	}
+}
 
-	// generate the 2d texture
+void Model::queueTextureDecode(const std::string& path, TextureType type, const std::string& directory, TextureDecodes& decodes, const TextureJobs& jobs) {
+	std::string key = textureDecodeKey(path, type);
+	if (decodes.count(key)) return;
 
-	if (data) {
-		GLenum format;
-		if (nrComponents == 1) format = GL_RED;
-		else if (nrComponents == 3) format = GL_RGB;
-		else if (nrComponents == 4) format = GL_RGBA;
+	// empty futures are kept for skipped files so they aren't looked up again
+	std::string fullPath = directory + '/' + path;
+	TextureDecode& decode = decodes[key];
+	if (jobs.skipCached && TextureCache::shared().contains(TextureCache::canonicalPath(fullPath) + textureVariant(jobs, type))) return;
+
+	// the other slot's entry already decodes the file, only the encode differs
+	auto sibling = decodes.find(key == path ? textureDecodeKey(path, TEXTURE_NORMAL) : path);
+	if (sibling != decodes.end() && sibling->second.image.valid()) decode.image = sibling->second.image;
+	else decode.image = decodeImageAsync(fullPath);
+
+	// the encode would otherwise run inside loadTexture on the GL thread and stall the frame it lands in
+	if (jobs.compress) {
+		TextureEncoding encoding = jobs.encoding;
+		encoding.normalMap = type == TEXTURE_NORMAL;
+		decode.compressed = TextureBlockCache::loadAsync(fullPath, decode.image, encoding, jobs.useCache);
+	}
+}
 
-		glBindTexture(GL_TEXTURE_2D, textureID);
+Texture Model::loadTexture(const TextureRef& ref) {
+	std::string variant = textureVariant(textureJobs(false), ref.type);
+	auto found = texturesByPath.find(ref.path + variant);
+	if (found != texturesByPath.end()) {
+		return textures_loaded[found->second]; // skip if a texture with the same filepath and encoding is already loaded
+	}
 
-		glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-		glGenerateMipmap(GL_TEXTURE_2D);
+	// other Models may already hold this file, the shared cache only loads it on a miss.
+	// The pixels normally come from a decode that already finished on the worker pool
+	std::string key = TextureCache::canonicalPath(this->directory + '/' + ref.path) + variant;
+	TextureHandle handle(key, [&]() {
+		if (settings.compressTextures) return compressedTextureFromFile(ref);
+		if (TextureResidency::shared().enabled()) return mipChainTextureFromFile(ref);
+		if (ref.image.valid()) return uploadImageTexture(*ref.image.get());
+		return TextureFromFile(ref.path.c_str(), this->directory);
+	});
 
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	Texture texture;
+	texture.id = handle.id();
+	texture.type = ref.type;
+	texture.path = ref.path;
 
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	texturesByPath[ref.path + variant] = static_cast<unsigned int>(textures_loaded.size());
+	textures_loaded.push_back(texture);
+	texture_handles.push_back(std::move(handle));
+	return texture;
+}
 
-		stbi_image_free(data);
+// a stored chain copied out of the mapped file
+static CompressedImage packageTextureImage(const ModelPackage& package, unsigned int index) {
+	const PackageTexture& stored = package.texture(index);
+	CompressedImage image;
+	image.format = static_cast<BlockFormat>(stored.format);
+	for (unsigned int m = 0; m < stored.numMips; m++) {
+		const PackageMip& mip = package.mip(stored.firstMip + m);
+		CompressedMip level = { image.pixels.size(), mip.bytes, mip.width, mip.height };
+		image.pixels.insert(image.pixels.end(), package.mipData(mip), package.mipData(mip) + mip.bytes);
+		image.mips.push_back(level);
 	}
-	else {
-		std::cout << "Texture load unsuccesfully at: " << path << std::endl;
-		stbi_image_free(data);
+	return image;
+}
+
+// same sharing as loadTexture, the stored mips are uploaded as they are
+Texture Model::loadPackageTexture(const ModelPackage& package, unsigned int index, TextureType type) {
+	const PackageTexture& stored = package.texture(index);
+	std::string path = package.string(stored.path);
+	std::string variant = packageTextureVariant(stored);
+
+	Texture texture;
+	auto found = texturesByPath.find(path + variant);
+	if (found != texturesByPath.end()) {
+		texture = textures_loaded[found->second];
+		texture.type = type;
+		return texture;
 	}
 
+	std::string key = TextureCache::canonicalPath(this->directory + '/' + path) + variant;
+	TextureHandle handle(key, [&]() {
+		std::vector<TextureLevel> levels;
+		for (unsigned int m = 0; m < stored.numMips; m++) {
+			const PackageMip& mip = package.mip(stored.firstMip + m);
+			levels.push_back({ package.mipData(mip), static_cast<size_t>(mip.bytes), static_cast<int>(mip.width), static_cast<int>(mip.height) });
+		}
+		if (levels.empty()) std::cout << "Texture load unsuccesfully at: " << path << std::endl;
+		unsigned int textureID = uploadTextureLevels(levels.data(), levels.size(), static_cast<BlockFormat>(stored.format));
+
+		// dropped levels come back out of the package file, it is opened again on a worker
+		std::string packagePath = package.path();
+		TextureResidency::shared().track(textureID, static_cast<BlockFormat>(stored.format), levels.data(), levels.size(), [packagePath, index]() {
+			ModelPackage source;
+			CompressedImage image;
+			if (source.open(packagePath) && index < source.count(PACKAGE_TEXTURES)) image = packageTextureImage(source, index);
+			return image;
+		});
+		return textureID;
+	});
+
+	texture.id = handle.id();
+	texture.type = type;
+	texture.path = path;
+
+	texturesByPath[path + variant] = static_cast<unsigned int>(textures_loaded.size());
+	textures_loaded.push_back(texture);
+	texture_handles.push_back(std::move(handle));
+	return texture;
+}
+
+// BC1, BC3, BC5 or BC7 by how the material uses the texture. The cache read or encode was queued on the
+// worker pool next to the decode, only the upload happens here. Encoding only runs on the first load,
+// after that the chain comes from the block cache
+unsigned int Model::compressedTextureFromFile(const TextureRef& ref) {
+	std::string fullPath = this->directory + '/' + ref.path;
+
+	TextureEncoding encoding = textureJobs(false).encoding;
+	encoding.normalMap = ref.type == TEXTURE_NORMAL;
+
+	// a ref without queued work (the file was skipped when the load started) is loaded here
+	CompressedImage loaded;
+	if (!ref.compressed.valid()) loaded = TextureBlockCache::load(fullPath, ref.image, encoding, settings.useMeshCache);
+	const CompressedImage& image = ref.compressed.valid() ? *ref.compressed.get() : loaded;
+	if (image.mips.empty()) std::cout << "Texture load unsuccesfully at: " << fullPath << std::endl;
+	unsigned int textureID = uploadCompressedImage(image);
+
+	// restores read the block cache, the cache entry was written above
+	TextureResidency::shared().track(textureID, image, [fullPath, encoding]() {
+		CompressedImage restored;
+		if (TextureBlockCache::read(fullPath, encoding, restored)) return restored;
+		std::shared_ptr<DecodedImage> decoded = decodeImage(fullPath);
+		return compressImage(*decoded, encoding.normalMap, encoding.quality, encoding.allowBC7);
+	});
 	return textureID;
+}
+
+// RGBA8 levels built on the CPU instead of by glGenerateMipmap, so a residency manager
+// that dropped the top ones can build them again
+unsigned int Model::mipChainTextureFromFile(const TextureRef& ref) {
+	std::string fullPath = this->directory + '/' + ref.path;
 
-}
\ No newline at end of file
+	std::shared_ptr<DecodedImage> decoded = ref.image.valid() ? ref.image.get() : decodeImage(fullPath);
+	CompressedImage image = compressMipChain(buildMipChain(*decoded), BLOCK_FORMAT_NONE, COMPRESSION_NORMAL);
+	if (image.mips.empty()) std::cout << "Texture load unsuccesfully at: " << fullPath << std::endl;
+	unsigned int textureID = uploadCompressedImage(image);
+
+	TextureResidency::shared().track(textureID, image, [fullPath]() {
+		return compressMipChain(buildMipChain(*decodeImage(fullPath)), BLOCK_FORMAT_NONE, COMPRESSION_NORMAL);
+	});
+	return textureID;
+}
+
+// synchronous fallback for textures that had no decode queued
+unsigned int Model::TextureFromFile(const char* path, const std::string& directory, bool gamma) {
+	std::string filename = std::string(path);
+
+	filename = directory + '/' + filename;
+
+	return uploadImageTexture(*decodeImage(filename));
+}
@@ -14,6 +14,27 @@
 #include "stb_image.h"
 
 #include "mesh_data.h"
+#include "mesh_cache.h"
+#include "animation_cache.h"
+#include "model_package.h"
+#include "mega_buffer.h"
+#include "instance_buffer.h"
+#include "frustum.h"
+#include "bvh.h"
+#include "transform_graph.h"
+#include "mesh_optimizer.h"
+#include "mesh_simplifier.h"
+#include "skeleton.h"
+#include "animator.h"
+#include "skinning.h"
+#include "thread_pool.h"
+#include "mpsc_queue.h"
+#include "texture_cache.h"
+#include "texture_loader.h"
+#include "texture_block_cache.h"
+#include "texture_residency.h"
+#include "material_arrays.h"
+#include "gl_extensions.h"
 
 // Assimp library for loading models
 #include <assimp/Importer.hpp>
@@ -25,26 +46,227 @@
 #include <sstream>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
+
+// assimp post processing applied on import, part of the mesh cache key
+#define MODEL_IMPORT_FLAGS (aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_CalcTangentSpace)
+
+// texture work started on the worker pool for one material file, before the meshes using it are processed
+struct TextureDecode {
+	DecodedImageFuture image;
+	CompressedImageFuture compressed;	// block cache read or encode behind the decode, empty unless textures are compressed
+};
+
+// material path, split by color and normal map slot -> its work on the pool
+typedef std::unordered_map<std::string, TextureDecode> TextureDecodes;
+
+// the same file in a color slot and a normal map slot is compressed twice, so it has two entries in TextureDecodes
+inline std::string textureDecodeKey(const std::string& path, TextureType type) {
+	return type == TEXTURE_NORMAL ? path + "#normal" : path;
+}
+
+// how the texture work of a load is started, filled in on the GL thread before the load begins
+struct TextureJobs {
+	bool skipCached = false;	// start nothing for files another Model already uploaded, consults the TextureCache so GL thread only
+	bool compress = false;		// chain a block cache read or encode behind every decode
+	TextureEncoding encoding;	// normalMap is set per file from the slot it is used in
+	bool useCache = true;		// of the block cache
+};
+
+// message from the background loader to the GL thread, one per finished mesh
+// plus a final one with slot -1 once the whole model is done
+struct AsyncMeshResult {
+	int slot = -1;					// index in meshes_list
+	unsigned int total = 0;			// number of meshes in the model
+	bool failed = false;
+	std::shared_ptr<const MeshData> data;
+};
+
+// size and bounds of all the meshes of a model, known before any of them is processed
+struct MeshTotals {
+	size_t numVertices = 0;
+	size_t numIndices = 0;
+	glm::vec3 boundsMin = glm::vec3(0.0f);
+	glm::vec3 boundsMax = glm::vec3(0.0f);
+};
+
+// shared between a Model and its background load tasks so the Model itself can move freely
+struct AsyncLoadState {
+	MPSCQueue<AsyncMeshResult> completed;
+	MeshTotals totals;	// written before the first result is pushed
+	std::shared_ptr<const Skeleton> skeleton;	// same, node hierarchy, bones and clips
+};
+
+// meshes a culled draw submitted and skipped, placeholders still streaming in count as neither
+struct CullStats {
+	unsigned int drawn = 0;
+	unsigned int culled = 0;
+};
+
+// how a Model is imported and uploaded
+struct ModelSettings {
+	bool gammaCorrection = false;
+	bool useMeshCache = true;
+	VertexFormat vertexFormat = VERTEX_FORMAT_FULL;
+	bool packMeshes = false;	// one shared vertex/index buffer, drawn with a multi draw call per material
+	bool optimizeMeshes = false;	// vertex cache, overdraw and fetch optimization on import, stored in the mesh cache
+	std::vector<float> lodRatios;	// triangle ratio of each simplified LOD built on import, no LODs when empty
+	float lodPixelError = 1.0f;		// coarsest LOD whose error projects under this many pixels is drawn
+	bool cpuSkinning = false;		// pose skinned meshes with skinVertices instead of in the vertex shader
+	bool releaseCpuGeometry = false;	// drop Mesh::vertices/indices once uploaded, CPU skinned meshes keep their bind pose
+	bool compressTextures = false;	// block compress material textures on load, the results are cached next to the meshes
+	CompressionQuality textureQuality = COMPRESSION_NORMAL;
+	bool packMaterials = false;		// copy same shaped material textures into texture arrays once loaded, meshes then only switch layers
+
+	// MESH_PROCESS_* flags the cache entry has to match
+	unsigned int processFlags() const;
+};
+
 class Model {
 public:
 	// constructor
 	std::vector<Mesh> meshes_list;
 	std::string directory;
 	std::vector<Texture> textures_loaded;
+	std::vector<TextureHandle> texture_handles;	// this Model's references in the TextureCache, one per textures_loaded entry
 	bool gammaCorrection;
+	ModelSettings settings;
+	std::unique_ptr<MegaBuffer> megaBuffer;	// shared buffers of the packed meshes, null unless settings.packMeshes
+	std::unique_ptr<MaterialArrays> materialArrays;	// null unless settings.packMaterials
+	std::shared_ptr<const Skeleton> skeleton;	// bones and clips, null when the file has neither
+	Animator animator;						// pose Draw(shader) uses, plays the first clip
+	TransformGraph nodes;					// scene nodes of the file, setLocal moves a node and the meshes under it
+	std::vector<std::string> nodeNames;		// per node
+	glm::vec3 boundsMin = glm::vec3(0.0f);	// object space box and sphere around every uploaded mesh
+	glm::vec3 boundsMax = glm::vec3(0.0f);
+	glm::vec3 sphereCenter = glm::vec3(0.0f);
+	float sphereRadius = 0.0f;
+
+	Model(std::string const &path, bool gamma = false, bool meshCache = true) : gammaCorrection(gamma) {
+		settings.gammaCorrection = gamma;
+		settings.useMeshCache = meshCache;
+		loadModel(path);
+		updateBounds();
+	}
 
-	Model(std::string const &path, bool gamma = false) : gammaCorrection(gamma) {
+	Model(std::string const& path, const ModelSettings& modelSettings) : gammaCorrection(modelSettings.gammaCorrection), settings(modelSettings) {
 		loadModel(path);
+		updateBounds();
 	}
-	void Draw(Shader& shader);
+
+	// start loading on the worker pool and return right away, meshes become drawable
+	// one by one as pollAsyncLoad() uploads them. Cooked packages load synchronously, there is nothing to parse
+	static Model LoadAsync(std::string const& path, const ModelSettings& modelSettings = ModelSettings());
+
+	// call once per frame on the GL thread, uploads at most maxUploads finished meshes
+	void pollAsyncLoad(unsigned int maxUploads = 4);
+	bool isLoading() const { return asyncLoad != nullptr; }
+
+	// the model uniform is set per mesh, to model times the world matrix of the mesh's node
+	void Draw(Shader& shader, const glm::mat4& model = glm::mat4(1.0f));
+
+	// draw in the pose of another character sharing this model's skeleton
+	void Draw(Shader& shader, Animator& pose, const glm::mat4& model = glm::mat4(1.0f));
+	// one copy per transform with a single instanced call per mesh, the model uniform carries the node's world matrix.
+	// The transforms go into an instance buffer the Model keeps and reuses every frame
+	void DrawInstanced(Shader& shader, const glm::mat4* transforms, size_t count);
+	void DrawInstanced(Shader& shader, const std::vector<glm::mat4>& transforms);
+	void DrawInstanced(Shader& shader, Animator& pose, const glm::mat4* transforms, size_t count);
+
+	Animator createAnimator() const { return Animator(skeleton); }
+
+	// index in nodes of the first node with this name, -1 when there is none
+	int findNode(const std::string& name) const;
+
+	// bring the node worlds up to date, the Draw calls do it on their own. A clip the animator plays
+	// drives the node locals, nodes it animates move the meshes attached to them. Returns the number of nodes that moved
+	size_t updateTransforms();
+	// same, with the node locals of another character's animator, switching between poses moves only the nodes that differ
+	size_t updateTransforms(const Animator& pose);
+
+	// where a mesh sits in the model, its node's world matrix. Identity for skinned meshes, the bones place them
+	const glm::mat4& meshTransform(size_t mesh) const;
+
+	// skeletons that don't fit the palette block are always posed on the CPU
+	bool usesCpuSkinning() const { return skeleton && (settings.cpuSkinning || skeleton->boneCount() > MAX_BONES); }
+
+	// cull the meshes against the camera's frustum, pick the LOD of the ones left from how big
+	// their error shows on screen, then draw them
+	void Draw(Shader& shader, const Camera& camera, const glm::mat4& projection, const glm::mat4& model, float screenHeight);
+	void cull(const glm::mat4& viewProjection, const glm::mat4& model);
+	void selectLods(const Camera& camera, const glm::mat4& model, float screenHeight);
+
+	// world space box of every mesh, to put the model into a scene Bvh. Placeholders of a model
+	// that is still loading get an empty box at the origin
+	void meshWorldBounds(const glm::mat4& model, std::vector<glm::vec3>& boundsMin, std::vector<glm::vec3>& boundsMax) const;
+
+	// meshes drawn and culled by the last Draw with a camera
+	const CullStats& cullStats() const { return lastCull; }
+
+	// GPU memory held by the vertex buffers of the uploaded meshes
+	size_t vertexMemory() const;
+	size_t indexMemory() const;
+
+	// mesh count, index types and GPU memory of the geometry
+	void printStats() const;
+
+	// assimp import and post processing of every mesh without touching GL, for tools like the asset cooker.
+	// Texture references are kept as the materials name them, nothing is decoded
+	static bool importMeshes(const std::string& path, const ModelSettings& settings, std::vector<MeshData>& meshes, Skeleton& skeleton);
 
 private:
-	
+	std::shared_ptr<AsyncLoadState> asyncLoad;
+	std::unordered_map<std::string, unsigned int> texturesByPath;	// material path and encoding -> index in textures_loaded
+	InstanceBuffer instances;			// per instance transforms of DrawInstanced
+	BoundingSpheres meshSpheres;		// one per meshes_list entry, rebuilt whenever meshes are uploaded
+	std::vector<uint8_t> meshVisible;	// result of the last cull
+	CullStats lastCull;
+	std::vector<Vertex> posedVertices;	// CPU skinning output, sized for the biggest mesh so posing doesn't allocate
+	std::vector<glm::mat4> meshTransforms;	// meshTransform() of every mesh, refreshed with the bounds
+
+	explicit Model(const ModelSettings& modelSettings) : gammaCorrection(modelSettings.gammaCorrection), settings(modelSettings) {}
+
 	void loadModel(std::string const& path);
-	void processNode(aiNode* node, const aiScene* scene);
-	Mesh processMesh(aiMesh* mesh, const aiScene* scene);
-	std::vector<Texture> loadMaterialTextures(aiMaterial* mat, aiTextureType type, std::string typeName);
+	bool loadCachedModel(std::string const& path);
+	bool loadPackage(std::string const& path);
+	Mesh setupMeshView(const CachedMeshView& view, std::vector<Texture> textures);
+	std::vector<MeshData> processNode(aiNode* node, const aiScene* scene, const TextureDecodes& decodes, const Skeleton& bones);
+	Mesh setupMeshData(const MeshData& data);
+	bool keepsGeometry(const Mesh& mesh) const;
+	Mesh setupCpuSkinnedMesh(const Vertex* vertices, size_t numVertices, const unsigned int* indices, size_t numIndices, std::vector<Texture> textures,
+		const std::vector<MeshLod>& lods);
+	void beginPacking(const MeshTotals& totals);
+	void packMaterialArrays();
+	void setSkeleton(std::shared_ptr<const Skeleton> bones);
+	void buildNodes(const Skeleton& hierarchy);
+	void drawMeshes(Shader& shader, Animator& pose, const InstanceBuffer* instanceData, const uint8_t* visible, const glm::mat4& model);
+	void skinOnCpu(const Animator& pose, const uint8_t* visible);
+	void updateBounds();
+
+	// CPU only import steps, safe to run on worker threads
+	static void runAsyncLoad(std::shared_ptr<AsyncLoadState> state, std::string path, ModelSettings settings, TextureJobs jobs);
+	static void collectMeshes(aiNode* node, const aiScene* scene, std::vector<aiMesh*>& sceneMeshes, std::vector<unsigned int>& meshNodes);
+	static MeshTotals sceneTotals(const std::vector<aiMesh*>& sceneMeshes);
+	static MeshTotals cacheTotals(const MeshCache& cache);
+	static MeshTotals packageTotals(const ModelPackage& package);
+	static MeshData processMesh(aiMesh* mesh, const aiScene* scene, const TextureDecodes& decodes, const Skeleton& bones);
+	static void addBoneWeight(Vertex& vertex, int bone, float weight);
+	static void postProcessMesh(MeshData& data, const ModelSettings& settings, MeshOptimizeReport* report);
+	static std::vector<TextureRef> materialTextureRefs(aiMaterial* mat, aiTextureType type, TextureType typeName, const TextureDecodes& decodes);
+
+	// start decoding, and compressing when the settings ask for it, as soon as the material list is known
+	TextureJobs textureJobs(bool skipCached) const;
+	static TextureDecodes startTextureDecodes(const aiScene* scene, const std::string& directory, const TextureJobs& jobs);
+	static void attachTextureDecodes(std::vector<TextureRef>& textures, const std::string& directory, TextureDecodes& decodes, const TextureJobs& jobs);
+	static void queueTextureDecode(const std::string& path, TextureType type, const std::string& directory, TextureDecodes& decodes, const TextureJobs& jobs);
+
+	Texture loadTexture(const TextureRef& ref);
+	Texture loadPackageTexture(const ModelPackage& package, unsigned int index, TextureType type);
+	unsigned int compressedTextureFromFile(const TextureRef& ref);
+	unsigned int mipChainTextureFromFile(const TextureRef& ref);
 	unsigned int TextureFromFile(const char* path, const std::string& directory, bool gamma = false);
 
 };
@@ -1,11 +1,17 @@
-#version 330 core
-
-out vec4 FragColor;
-
-in vec2 TexCoords;
-
-uniform sampler2D texture_diffuse1;
-
-void main(){
-	FragColor = texture(texture_diffuse1, TexCoords);
+#version 330 core
+
+out vec4 FragColor;
+
+in vec2 TexCoords;
+flat in int MaterialLayer;
+
+uniform sampler2D texture_diffuse1;
+
+// set when the mesh's material was packed into texture arrays, MaterialLayer picks its layer
+uniform bool materialArrays;
+uniform sampler2DArray material_diffuse1;
+
+void main(){
+	if (materialArrays) FragColor = texture(material_diffuse1, vec3(TexCoords, MaterialLayer));
+	else FragColor = texture(texture_diffuse1, TexCoords);
 }
\ No newline at end of file
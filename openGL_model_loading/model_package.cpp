@@ -0,0 +1,430 @@
+#include "model_package.h"
+#include "model.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+static const char MODEL_PACKAGE_MAGIC[4] = { 'M', 'P', 'K', 'G' };
+
+static uint64_t alignUp(uint64_t value) {
+	return (value + 15) & ~uint64_t(15);
+}
+
+// record size of the typed sections, 1 for the ones holding plain bytes
+static size_t elementSize(uint32_t kind) {
+	switch (kind) {
+	case PACKAGE_SOURCES: return sizeof(PackageSource);
+	case PACKAGE_MESHES: return sizeof(PackageMesh);
+	case PACKAGE_MESH_TEXTURES: return sizeof(PackageMeshTexture);
+	case PACKAGE_VERTICES: return sizeof(Vertex);
+	case PACKAGE_INDICES: return sizeof(uint32_t);
+	case PACKAGE_LODS: return sizeof(MeshLod);
+	case PACKAGE_TEXTURES: return sizeof(PackageTexture);
+	case PACKAGE_MIPS: return sizeof(PackageMip);
+	default: return 1;
+	}
+}
+
+bool ModelPackage::open(const std::string& path) {
+	close();
+	if (!file.open(path)) return false;
+
+	head = reinterpret_cast<const PackageHeader*>(file.data());
+	sections = reinterpret_cast<const PackageSection*>(file.data() + sizeof(PackageHeader));
+	if (!validate()) {
+		std::cout << "ERROR::MODEL_PACKAGE::CORRUPT_OR_OLD_VERSION: " << path << std::endl;
+		close();
+		return false;
+	}
+	filePath = path;
+	return true;
+}
+
+void ModelPackage::close() {
+	file.close();
+	filePath.clear();
+	head = nullptr;
+	sections = nullptr;
+}
+
+// the cooker wrote the file, so nothing is hashed on load. Every offset and index is still
+// checked once here, after that the loader follows them without any checks of its own
+bool ModelPackage::validate() const {
+	const uint64_t fileSize = file.size();
+	if (fileSize < sizeof(PackageHeader)) return false;
+	if (std::memcmp(head->magic, MODEL_PACKAGE_MAGIC, 4) != 0) return false;
+	if (head->version != MODEL_PACKAGE_VERSION || head->vertexSize != sizeof(Vertex)) return false;
+	if (head->sectionCount != PACKAGE_SECTION_COUNT || head->fileSize != fileSize) return false;
+	if (sizeof(PackageHeader) + uint64_t(PACKAGE_SECTION_COUNT) * sizeof(PackageSection) > fileSize) return false;
+
+	for (uint32_t kind = 0; kind < PACKAGE_SECTION_COUNT; kind++) {
+		const PackageSection& entry = sections[kind];
+		if (entry.kind != kind || entry.offset % 16) return false;
+		if (entry.offset + entry.bytes > fileSize || entry.bytes != uint64_t(entry.count) * elementSize(kind)) return false;
+	}
+
+	uint64_t stringBytes = bytes(PACKAGE_STRINGS);
+	auto validString = [&](const PackageString& text) { return uint64_t(text.offset) + text.length <= stringBytes; };
+
+	for (uint32_t i = 0; i < count(PACKAGE_SOURCES); i++) {
+		if (!validString(section<PackageSource>(PACKAGE_SOURCES)[i].path)) return false;
+	}
+
+	const MeshLod* lods = section<MeshLod>(PACKAGE_LODS);
+	for (uint32_t i = 0; i < count(PACKAGE_MESHES); i++) {
+		const PackageMesh& entry = section<PackageMesh>(PACKAGE_MESHES)[i];
+		if (uint64_t(entry.firstVertex) + entry.numVertices > count(PACKAGE_VERTICES)) return false;
+		if (uint64_t(entry.firstIndex) + entry.numIndices > count(PACKAGE_INDICES)) return false;
+		if (uint64_t(entry.firstTexture) + entry.numTextures > count(PACKAGE_MESH_TEXTURES)) return false;
+		if (uint64_t(entry.firstLod) + entry.numLods > count(PACKAGE_LODS)) return false;
+		for (uint32_t l = 0; l < entry.numLods; l++) {
+			const MeshLod& lod = lods[entry.firstLod + l];
+			if (uint64_t(lod.firstIndex) + lod.indexCount > entry.numIndices) return false;
+		}
+	}
+
+	for (uint32_t i = 0; i < count(PACKAGE_MESH_TEXTURES); i++) {
+		const PackageMeshTexture& reference = section<PackageMeshTexture>(PACKAGE_MESH_TEXTURES)[i];
+		TextureType type;
+		if (reference.texture >= count(PACKAGE_TEXTURES) || !validString(reference.type) || !textureTypeFromName(string(reference.type), type)) return false;
+	}
+
+	for (uint32_t i = 0; i < count(PACKAGE_TEXTURES); i++) {
+		const PackageTexture& entry = texture(i);
+		if (!validString(entry.path) || entry.source >= count(PACKAGE_SOURCES)) return false;
+		if (!validBlockFormat(entry.format)) return false;
+		if (uint64_t(entry.firstMip) + entry.numMips > count(PACKAGE_MIPS)) return false;
+
+		for (uint32_t m = 0; m < entry.numMips; m++) {
+			const PackageMip& level = mip(entry.firstMip + m);
+			if (level.width == 0 || level.height == 0 || level.width > 16384 || level.height > 16384) return false;
+			uint64_t expected = entry.format == BLOCK_FORMAT_NONE ? uint64_t(level.width) * level.height * 4
+				: compressedSize(static_cast<BlockFormat>(entry.format), level.width, level.height);
+			if (level.bytes != expected || level.offset + level.bytes > bytes(PACKAGE_PIXELS)) return false;
+		}
+	}
+	return true;
+}
+
+std::string ModelPackage::string(const PackageString& text) const {
+	return std::string(section<char>(PACKAGE_STRINGS) + text.offset, text.length);
+}
+
+CachedMeshView ModelPackage::mesh(unsigned int index) const {
+	const PackageMesh& entry = section<PackageMesh>(PACKAGE_MESHES)[index];
+
+	CachedMeshView view;
+	view.vertices = section<Vertex>(PACKAGE_VERTICES) + entry.firstVertex;
+	view.numVertices = entry.numVertices;
+	view.indices = section<unsigned int>(PACKAGE_INDICES) + entry.firstIndex;
+	view.numIndices = entry.numIndices;
+	view.node = entry.node;
+
+	for (uint32_t t = 0; t < entry.numTextures; t++) {
+		const PackageMeshTexture& reference = section<PackageMeshTexture>(PACKAGE_MESH_TEXTURES)[entry.firstTexture + t];
+		TextureRef ref;
+		ref.type = TEXTURE_DIFFUSE;
+		textureTypeFromName(string(reference.type), ref.type);
+		ref.path = string(texture(reference.texture).path);
+		view.textures.push_back(ref);
+	}
+
+	const MeshLod* lods = section<MeshLod>(PACKAGE_LODS) + entry.firstLod;
+	view.lods.assign(lods, lods + entry.numLods);
+	return view;
+}
+
+
+// whole file hashed, false when it can't be read
+static bool hashFile(const std::string& path, uint64_t& hash) {
+	MappedFile file;
+	if (!file.open(path)) return false;
+	hash = cacheHash(file.data(), file.size());
+	return true;
+}
+
+// .mtl files an .obj names, editing them changes the materials without touching the model file
+static std::vector<std::string> materialLibraries(const std::string& modelPath) {
+	std::vector<std::string> libraries;
+	std::ifstream in(modelPath);
+	std::string line;
+	while (std::getline(in, line)) {
+		if (line.compare(0, 7, "mtllib ") != 0) continue;
+		std::stringstream names(line.substr(7));
+		std::string name;
+		while (names >> name) libraries.push_back(name);
+	}
+	return libraries;
+}
+
+// offline there is no driver to ask, BC7 is always allowed and decoded on load where it isn't supported
+static CompressedImage cookTexture(const std::string& path, bool normalMap, const CookSettings& settings) {
+	std::vector<MipLevel> levels = buildMipChain(*decodeImage(path));
+	if (levels.empty()) {
+		std::cout << "ERROR::MODEL_PACKAGE::TEXTURE_NOT_LOADED: " << path << std::endl;
+		return CompressedImage();
+	}
+
+	BlockFormat format = BLOCK_FORMAT_NONE;
+	if (settings.compressTextures) format = chooseBlockFormat(normalMap, hasTransparency(levels[0]), settings.quality, true);
+	return compressMipChain(levels, format, settings.quality);
+}
+
+// the sections of a package being written, strings are shared between everything naming them
+class PackageWriter {
+public:
+	std::vector<unsigned char> sections[PACKAGE_SECTION_COUNT];
+
+	template <typename T> void add(PackageSectionKind kind, const T& record) { add(kind, &record, 1); }
+	template <typename T> void add(PackageSectionKind kind, const T* records, size_t count) {
+		const unsigned char* begin = reinterpret_cast<const unsigned char*>(records);
+		sections[kind].insert(sections[kind].end(), begin, begin + count * sizeof(T));
+	}
+	template <typename T> uint32_t count(PackageSectionKind kind) const {
+		return static_cast<uint32_t>(sections[kind].size() / sizeof(T));
+	}
+
+	PackageString addString(const std::string& text) {
+		auto found = strings.find(text);
+		if (found != strings.end()) return found->second;
+
+		PackageString stored = { static_cast<uint32_t>(sections[PACKAGE_STRINGS].size()), static_cast<uint32_t>(text.size()) };
+		add(PACKAGE_STRINGS, text.data(), text.size());
+		strings[text] = stored;
+		return stored;
+	}
+
+	std::vector<unsigned char> build(PackageHeader header) const {
+		PackageSection toc[PACKAGE_SECTION_COUNT];
+		uint64_t offset = alignUp(sizeof(PackageHeader) + sizeof(toc));
+		for (uint32_t kind = 0; kind < PACKAGE_SECTION_COUNT; kind++) {
+			toc[kind].kind = kind;
+			toc[kind].offset = offset;
+			toc[kind].bytes = sections[kind].size();
+			toc[kind].count = static_cast<uint32_t>(sections[kind].size() / elementSize(kind));
+			offset = alignUp(offset + sections[kind].size());
+		}
+		header.sectionCount = PACKAGE_SECTION_COUNT;
+		header.fileSize = offset;
+
+		std::vector<unsigned char> file(offset, 0);
+		std::memcpy(file.data(), &header, sizeof(header));
+		std::memcpy(file.data() + sizeof(header), toc, sizeof(toc));
+		for (uint32_t kind = 0; kind < PACKAGE_SECTION_COUNT; kind++) {
+			if (!sections[kind].empty()) std::memcpy(file.data() + toc[kind].offset, sections[kind].data(), sections[kind].size());
+		}
+		return file;
+	}
+
+private:
+	std::unordered_map<std::string, PackageString> strings;
+};
+
+bool cookModelPackage(const std::string& modelPath, const std::string& packagePath, const CookSettings& settings) {
+	auto start = std::chrono::steady_clock::now();
+	// either separator, and a bare file name lives in the working directory
+	std::string directory = fs::path(modelPath).parent_path().string();
+	if (directory.empty()) directory = ".";
+
+	ModelSettings modelSettings;
+	modelSettings.optimizeMeshes = settings.optimizeMeshes;
+	modelSettings.lodRatios = settings.lodRatios;
+
+	// the model and its material files decide the geometry
+	std::vector<std::string> sourcePaths = { fs::path(modelPath).filename().string() };
+	for (const std::string& library : materialLibraries(modelPath)) sourcePaths.push_back(library);
+
+	std::vector<uint64_t> sourceHashes(sourcePaths.size(), 0);
+	if (!hashFile(modelPath, sourceHashes[0])) {
+		std::cout << "ERROR::MODEL_PACKAGE::MODEL_NOT_FOUND: " << modelPath << std::endl;
+		return false;
+	}
+	for (size_t i = 1; i < sourcePaths.size(); i++) hashFile(directory + '/' + sourcePaths[i], sourceHashes[i]);
+
+	std::vector<uint64_t> meshKey = { MODEL_PACKAGE_VERSION, sizeof(Vertex), MODEL_IMPORT_FLAGS, modelSettings.processFlags() };
+	meshKey.insert(meshKey.end(), sourceHashes.begin(), sourceHashes.end());
+	uint64_t meshHash = cacheHash(reinterpret_cast<const unsigned char*>(meshKey.data()), meshKey.size() * sizeof(uint64_t));
+
+	ModelPackage previous;
+	bool havePrevious = !settings.force && previous.open(packagePath);
+
+	// geometry: copied from the previous package when its inputs are unchanged, imported otherwise
+	std::vector<MeshData> meshes;
+	std::vector<unsigned char> skeletonBlob;
+	bool reuseMeshes = havePrevious && previous.header().meshHash == meshHash;
+	if (reuseMeshes) {
+		for (unsigned int i = 0; i < previous.count(PACKAGE_MESHES); i++) {
+			CachedMeshView view = previous.mesh(i);
+			MeshData data;
+			data.vertices.assign(view.vertices, view.vertices + view.numVertices);
+			data.indices.assign(view.indices, view.indices + view.numIndices);
+			data.textures = view.textures;
+			data.lods = view.lods;
+			data.node = view.node;
+			meshes.push_back(std::move(data));
+		}
+		const unsigned char* blob = previous.section<unsigned char>(PACKAGE_SKELETON);
+		skeletonBlob.assign(blob, blob + previous.bytes(PACKAGE_SKELETON));
+	}
+	else {
+		Skeleton skeleton;
+		if (!Model::importMeshes(modelPath, modelSettings, meshes, skeleton)) return false;
+		skeletonBlob = AnimationCache::serialize(skeleton);
+	}
+
+	// every texture the materials use, once each in order of first use. Normal maps get their own format
+	std::vector<std::string> texturePaths;
+	std::vector<uint8_t> normalMaps;
+	std::unordered_map<std::string, uint32_t> textureIndex;
+	for (const MeshData& mesh : meshes) {
+		for (const TextureRef& texture : mesh.textures) {
+			if (!textureIndex.count(texture.path)) {
+				textureIndex[texture.path] = static_cast<uint32_t>(texturePaths.size());
+				texturePaths.push_back(texture.path);
+				normalMaps.push_back(0);
+			}
+			if (texture.type == TEXTURE_NORMAL) normalMaps[textureIndex[texture.path]] = 1;
+		}
+	}
+
+	std::vector<uint64_t> textureHashes(texturePaths.size(), 0);
+	std::vector<uint8_t> textureFound(texturePaths.size(), 0);
+	for (size_t i = 0; i < texturePaths.size(); i++) textureFound[i] = hashFile(directory + '/' + texturePaths[i], textureHashes[i]);
+
+	std::vector<uint64_t> cookKey = { meshHash, settings.compressTextures ? 1u : 0u, settings.quality };
+	cookKey.insert(cookKey.end(), textureHashes.begin(), textureHashes.end());
+	uint64_t cookHash = cacheHash(reinterpret_cast<const unsigned char*>(cookKey.data()), cookKey.size() * sizeof(uint64_t));
+
+	if (havePrevious && previous.header().cookHash == cookHash) {
+		std::cout << "MODEL_PACKAGE::UP_TO_DATE: " << packagePath << std::endl;
+		return true;
+	}
+
+	// textures whose file and format are unchanged keep their mips, the rest are encoded on the worker pool
+	std::unordered_map<std::string, uint32_t> previousTextures;
+	if (havePrevious) {
+		for (uint32_t i = 0; i < previous.count(PACKAGE_TEXTURES); i++) previousTextures[previous.string(previous.texture(i).path)] = i;
+	}
+
+	std::vector<CompressedImage> cooked(texturePaths.size());
+	std::vector<size_t> encode;
+	for (size_t i = 0; i < texturePaths.size(); i++) {
+		auto found = previousTextures.find(texturePaths[i]);
+		if (textureFound[i] && found != previousTextures.end()) {
+			const PackageTexture& old = previous.texture(found->second);
+			const PackageSource& oldSource = previous.section<PackageSource>(PACKAGE_SOURCES)[old.source];
+			bool sameEncoding = old.quality == settings.quality && (old.format != BLOCK_FORMAT_NONE) == settings.compressTextures
+				&& (old.format == BLOCK_FORMAT_BC5) == (normalMaps[i] && settings.compressTextures);
+			if (old.numMips > 0 && oldSource.contentHash == textureHashes[i] && sameEncoding) {
+				cooked[i].format = static_cast<BlockFormat>(old.format);
+				for (uint32_t m = 0; m < old.numMips; m++) {
+					const PackageMip& mip = previous.mip(old.firstMip + m);
+					const unsigned char* data = previous.mipData(mip);
+					cooked[i].mips.push_back({ cooked[i].pixels.size(), mip.bytes, mip.width, mip.height });
+					cooked[i].pixels.insert(cooked[i].pixels.end(), data, data + mip.bytes);
+				}
+				continue;
+			}
+		}
+		if (textureFound[i]) encode.push_back(i);
+		else std::cout << "ERROR::MODEL_PACKAGE::TEXTURE_NOT_FOUND: " << texturePaths[i] << std::endl;
+	}
+
+	ThreadPool::shared().parallelFor(encode.size(), [&](size_t e) {
+		size_t i = encode[e];
+		cooked[i] = cookTexture(directory + '/' + texturePaths[i], normalMaps[i], settings);
+	});
+
+	PackageWriter writer;
+	for (size_t i = 0; i < sourcePaths.size(); i++) {
+		PackageSource source = { writer.addString(sourcePaths[i]), 0, sourceHashes[i] };
+		writer.add(PACKAGE_SOURCES, source);
+	}
+
+	for (size_t i = 0; i < texturePaths.size(); i++) {
+		PackageSource source = { writer.addString(texturePaths[i]), 0, textureHashes[i] };
+		PackageTexture texture;
+		texture.path = source.path;
+		texture.format = cooked[i].format;
+		texture.quality = settings.quality;
+		texture.source = writer.count<PackageSource>(PACKAGE_SOURCES);
+		texture.firstMip = writer.count<PackageMip>(PACKAGE_MIPS);
+		texture.numMips = static_cast<uint32_t>(cooked[i].mips.size());
+		writer.add(PACKAGE_SOURCES, source);
+		writer.add(PACKAGE_TEXTURES, texture);
+
+		// mip data stays 16 byte aligned in the pixel section
+		uint64_t base = alignUp(writer.sections[PACKAGE_PIXELS].size());
+		writer.sections[PACKAGE_PIXELS].resize(base);
+		for (const CompressedMip& level : cooked[i].mips) {
+			PackageMip mip = { base + level.offset, level.bytes, level.width, level.height };
+			writer.add(PACKAGE_MIPS, mip);
+		}
+		writer.add(PACKAGE_PIXELS, cooked[i].pixels.data(), cooked[i].pixels.size());
+	}
+
+	for (const MeshData& data : meshes) {
+		PackageMesh mesh = {};
+		mesh.firstVertex = writer.count<Vertex>(PACKAGE_VERTICES);
+		mesh.numVertices = static_cast<uint32_t>(data.vertices.size());
+		mesh.firstIndex = writer.count<uint32_t>(PACKAGE_INDICES);
+		mesh.numIndices = static_cast<uint32_t>(data.indices.size());
+		mesh.firstLod = writer.count<MeshLod>(PACKAGE_LODS);
+		mesh.numLods = static_cast<uint32_t>(data.lods.size());
+		mesh.firstTexture = writer.count<PackageMeshTexture>(PACKAGE_MESH_TEXTURES);
+		mesh.numTextures = static_cast<uint32_t>(data.textures.size());
+		mesh.node = data.node;
+		writer.add(PACKAGE_MESHES, mesh);
+
+		writer.add(PACKAGE_VERTICES, data.vertices.data(), data.vertices.size());
+		writer.add(PACKAGE_INDICES, data.indices.data(), data.indices.size());
+		writer.add(PACKAGE_LODS, data.lods.data(), data.lods.size());
+		for (const TextureRef& texture : data.textures) {
+			PackageMeshTexture reference = { textureIndex[texture.path], writer.addString(textureTypeName(texture.type)) };
+			writer.add(PACKAGE_MESH_TEXTURES, reference);
+		}
+	}
+	writer.add(PACKAGE_SKELETON, skeletonBlob.data(), skeletonBlob.size());
+
+	PackageHeader header = {};
+	std::memcpy(header.magic, MODEL_PACKAGE_MAGIC, 4);
+	header.version = MODEL_PACKAGE_VERSION;
+	header.vertexSize = sizeof(Vertex);
+	header.cookHash = cookHash;
+	header.meshHash = meshHash;
+	std::vector<unsigned char> file = writer.build(header);
+
+	// the old package is still mapped for the copies above
+	previous.close();
+
+	std::error_code ec;
+	std::string tempPath = packagePath + ".tmp";
+	{
+		std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+		out.write(reinterpret_cast<const char*>(file.data()), file.size());
+		if (!out) {
+			std::cout << "ERROR::MODEL_PACKAGE::WRITE_FAILED: " << tempPath << std::endl;
+			return false;
+		}
+	}
+	fs::rename(tempPath, packagePath, ec);
+	if (ec) {
+		std::cout << "ERROR::MODEL_PACKAGE::WRITE_FAILED: " << ec.message() << std::endl;
+		fs::remove(tempPath, ec);
+		return false;
+	}
+
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "MODEL_PACKAGE::COOKED: " << packagePath << "\n"
+		<< "  meshes:   " << meshes.size() << (reuseMeshes ? " (reused)" : " (imported)") << "\n"
+		<< "  textures: " << texturePaths.size() << " (" << encode.size() << " encoded)\n"
+		<< "  size:     " << file.size() / 1024 << " KB in " << ms << " ms" << std::endl;
+	return true;
+}
@@ -0,0 +1,141 @@
+#ifndef MODEL_PACKAGE_H
+#define MODEL_PACKAGE_H
+
+#include "mesh_cache.h"
+#include "block_compress.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// A cooked model: geometry as Vertex and index streams, the skeleton, and every texture as a
+// block compressed mip chain, all in one file. The table of contents after the header gives
+// one section per kind, the runtime maps the file and reads the sections in place.
+#define MODEL_PACKAGE_EXTENSION ".pkg"
+#define MODEL_PACKAGE_VERSION 2
+
+enum PackageSectionKind : uint32_t {
+	PACKAGE_STRINGS = 0,		// chars, referenced by PackageString
+	PACKAGE_SOURCES,			// PackageSource, every input file with its content hash
+	PACKAGE_SKELETON,			// AnimationCache::serialize blob
+	PACKAGE_MESHES,				// PackageMesh
+	PACKAGE_MESH_TEXTURES,		// PackageMeshTexture
+	PACKAGE_VERTICES,			// Vertex
+	PACKAGE_INDICES,			// uint32_t
+	PACKAGE_LODS,				// MeshLod, index ranges relative to their mesh
+	PACKAGE_TEXTURES,			// PackageTexture
+	PACKAGE_MIPS,				// PackageMip
+	PACKAGE_PIXELS,				// block data of every mip
+	PACKAGE_SECTION_COUNT
+};
+
+struct PackageHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t vertexSize;
+	uint32_t sectionCount;
+	uint64_t fileSize;
+	uint64_t cookHash;		// every input and setting, the whole package is skipped when it matches
+	uint64_t meshHash;		// the model and material files plus the mesh settings, the geometry is reused when it matches
+};
+
+// the table of contents, sectionCount of them right after the header in PackageSectionKind order
+struct PackageSection {
+	uint32_t kind;
+	uint32_t count;		// elements, bytes for the untyped sections
+	uint64_t offset;	// from the start of the file, 16 byte aligned
+	uint64_t bytes;
+};
+
+struct PackageString {
+	uint32_t offset;	// in PACKAGE_STRINGS
+	uint32_t length;
+};
+
+struct PackageSource {
+	PackageString path;		// relative to the model's directory, the model itself first
+	uint32_t reserved;
+	uint64_t contentHash;
+};
+
+struct PackageMesh {
+	uint32_t firstVertex;
+	uint32_t numVertices;
+	uint32_t firstIndex;
+	uint32_t numIndices;
+	uint32_t firstLod;
+	uint32_t numLods;
+	uint32_t firstTexture;	// in PACKAGE_MESH_TEXTURES
+	uint32_t numTextures;
+	uint32_t node;
+	uint32_t reserved;
+};
+
+struct PackageMeshTexture {
+	uint32_t texture;		// in PACKAGE_TEXTURES
+	PackageString type;		// texture_diffuse, texture_specular...
+};
+
+struct PackageTexture {
+	PackageString path;		// as the material names it
+	uint32_t format;		// BlockFormat
+	uint32_t source;		// in PACKAGE_SOURCES
+	uint32_t firstMip;		// in PACKAGE_MIPS
+	uint32_t numMips;
+	uint32_t quality;		// CompressionQuality the mips were encoded with
+};
+
+struct PackageMip {
+	uint64_t offset;		// in PACKAGE_PIXELS
+	uint64_t bytes;
+	uint32_t width;
+	uint32_t height;
+};
+
+// read only view of a mapped package, open() checks every section and reference against the file size
+class ModelPackage {
+public:
+	bool open(const std::string& path);
+	void close();
+
+	const std::string& path() const { return filePath; }
+	const PackageHeader& header() const { return *head; }
+
+	template <typename T> const T* section(PackageSectionKind kind) const {
+		return reinterpret_cast<const T*>(file.data() + sections[kind].offset);
+	}
+	uint32_t count(PackageSectionKind kind) const { return sections[kind].count; }
+	uint64_t bytes(PackageSectionKind kind) const { return sections[kind].bytes; }
+
+	std::string string(const PackageString& text) const;
+
+	// geometry of one mesh, its LOD ranges and texture references
+	CachedMeshView mesh(unsigned int index) const;
+
+	const PackageTexture& texture(unsigned int index) const { return section<PackageTexture>(PACKAGE_TEXTURES)[index]; }
+	const PackageMip& mip(unsigned int index) const { return section<PackageMip>(PACKAGE_MIPS)[index]; }
+	const unsigned char* mipData(const PackageMip& level) const { return file.data() + sections[PACKAGE_PIXELS].offset + level.offset; }
+
+private:
+	MappedFile file;
+	std::string filePath;
+	const PackageHeader* head = nullptr;
+	const PackageSection* sections = nullptr;
+
+	bool validate() const;
+};
+
+// how a model is cooked
+struct CookSettings {
+	bool optimizeMeshes = false;
+	std::vector<float> lodRatios;
+	bool compressTextures = true;	// formats as chooseBlockFormat picks them. Off keeps RGBA8 mips
+	CompressionQuality quality = COMPRESSION_NORMAL;	// HIGH also moves opaque color textures to BC7
+	bool force = false;				// cook even when the package is up to date
+};
+
+// cook modelPath into packagePath. Only what changed since the last cook is redone: geometry is copied
+// from the old package while the model and material files hash the same, and so is every texture whose file does
+bool cookModelPackage(const std::string& modelPath, const std::string& packagePath, const CookSettings& settings);
+
+#endif
@@ -1,16 +1,57 @@
-#version 330 core
-
-layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
-layout (location = 2) in vec2 aTexCoords;
-
-out vec2 TexCoords;
-
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-
-void main(){
-	TexCoords = aTexCoords;
-	gl_Position = projection * view * model * vec4(aPos, 1.0);
-}
\ No newline at end of file
+#version 330 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+layout (location = 5) in ivec4 aBoneIDs;
+layout (location = 6) in vec4 aWeights;
+// per instance model matrix of DrawInstanced, takes locations 7 to 10 (INSTANCE_ATTRIBUTE in instance_buffer.h)
+layout (location = 7) in mat4 aInstanceModel;
+// layer of the material in the texture arrays (MATERIAL_LAYER_ATTRIBUTE in material_arrays.h), constant per draw
+// or a per vertex stream in packed buffers
+layout (location = 11) in int aMaterialLayer;
+
+out vec2 TexCoords;
+flat out int MaterialLayer;
+
+uniform mat4 model;
+// shared by every program, CAMERA_BLOCK_BINDING in uniform_buffer.h
+layout (std140) uniform Camera {
+	mat4 view;
+	mat4 projection;
+	vec4 cameraPosition;
+};
+uniform bool instanced;	// aInstanceModel places the instance, model is then only the node transform
+
+// compact meshes store positions as unorm16 inside their bounds, identity for full vertices
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
+
+// bone palette of the Animator being drawn, has to match MAX_BONES in skeleton.h
+const int MAX_BONES = 100;
+layout (std140) uniform BonePalette {
+	mat4 bones[MAX_BONES];
+};
+uniform bool skinned;
+
+void main(){
+	TexCoords = aTexCoords;
+	MaterialLayer = aMaterialLayer;
+	vec4 position = vec4(positionOffset + aPos * positionScale, 1.0);
+
+	if (skinned) {
+		// unused influences have a weight of 0, vertices without any keep their bind pose
+		mat4 skin = mat4(0.0);
+		float total = 0.0;
+		for (int i = 0; i < 4; i++) {
+			if (aWeights[i] > 0.0 && aBoneIDs[i] < MAX_BONES) {
+				skin += bones[aBoneIDs[i]] * aWeights[i];
+				total += aWeights[i];
+			}
+		}
+		if (total > 0.0) position = skin * position;
+	}
+
+	mat4 world = instanced ? aInstanceModel * model : model;
+	gl_Position = projection * view * world * position;
+}
@@ -0,0 +1,60 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+
+// Lock-free unbounded queue, any number of threads may push but only one thread may pop.
+// Used to hand finished work from the worker pool back to the GL thread, which polls it once per frame.
+// T must be default constructible
+template <typename T>
+class MPSCQueue {
+public:
+	MPSCQueue() {
+		Node* stub = new Node();
+		head.store(stub, std::memory_order_relaxed);
+		tail = stub;
+	}
+
+	~MPSCQueue() {
+		while (tail) {
+			Node* next = tail->next.load(std::memory_order_relaxed);
+			delete tail;
+			tail = next;
+		}
+	}
+
+	MPSCQueue(const MPSCQueue&) = delete;
+	MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+	// safe from any thread
+	void push(T value) {
+		Node* node = new Node();
+		node->value = std::move(value);
+
+		Node* previous = head.exchange(node, std::memory_order_acq_rel);
+		previous->next.store(node, std::memory_order_release);
+	}
+
+	// consumer thread only, false when nothing is ready yet
+	bool pop(T& out) {
+		Node* next = tail->next.load(std::memory_order_acquire);
+		if (!next) return false;
+
+		out = std::move(next->value);
+		delete tail;
+		tail = next; // next becomes the new stub, its value was moved out
+		return true;
+	}
+
+private:
+	struct Node {
+		std::atomic<Node*> next{ nullptr };
+		T value;
+	};
+
+	std::atomic<Node*> head;	// last pushed node, touched by producers
+	Node* tail;					// stub node before the oldest entry, touched by the consumer only
+};
+
+#endif
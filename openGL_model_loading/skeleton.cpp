@@ -0,0 +1,128 @@
+#include "skeleton.h"
+
+#include <iostream>
+
+// assimp matrices are row major, glm ones column major
+glm::mat4 toGlm(const aiMatrix4x4& m) {
+	glm::mat4 result;
+	result[0] = glm::vec4(m.a1, m.b1, m.c1, m.d1);
+	result[1] = glm::vec4(m.a2, m.b2, m.c2, m.d2);
+	result[2] = glm::vec4(m.a3, m.b3, m.c3, m.d3);
+	result[3] = glm::vec4(m.a4, m.b4, m.c4, m.d4);
+	return result;
+}
+
+int Skeleton::findNode(const std::string& name) const {
+	for (size_t i = 0; i < nodes.size(); i++) {
+		if (nodes[i].name == name) return static_cast<int>(i);
+	}
+	return -1;
+}
+
+int Skeleton::findClip(const std::string& name) const {
+	for (size_t i = 0; i < clips.size(); i++) {
+		if (clips[i].name == name) return static_cast<int>(i);
+	}
+	return -1;
+}
+
+// depth first, a node is always added before its children
+static void flattenNodes(const aiNode* node, int parent, std::vector<SkeletonNode>& nodes) {
+	SkeletonNode flat;
+	flat.name = node->mName.C_Str();
+	flat.parent = parent;
+	flat.bindLocal = toGlm(node->mTransformation);
+	flat.bone = -1;
+
+	int index = static_cast<int>(nodes.size());
+	nodes.push_back(flat);
+
+	for (unsigned int i = 0; i < node->mNumChildren; i++) {
+		flattenNodes(node->mChildren[i], index, nodes);
+	}
+}
+
+static AnimationClip loadClip(const aiAnimation* animation, const Skeleton& skeleton) {
+	AnimationClip clip;
+	clip.name = animation->mName.C_Str();
+	clip.duration = static_cast<float>(animation->mDuration);
+	clip.ticksPerSecond = static_cast<float>(animation->mTicksPerSecond);
+
+	for (unsigned int c = 0; c < animation->mNumChannels; c++) {
+		const aiNodeAnim* nodeAnim = animation->mChannels[c];
+
+		AnimationChannel channel;
+		channel.node = skeleton.findNode(nodeAnim->mNodeName.C_Str());
+		if (channel.node < 0) continue; // channel for a node the hierarchy doesn't have
+
+		for (unsigned int k = 0; k < nodeAnim->mNumPositionKeys; k++) {
+			const aiVectorKey& key = nodeAnim->mPositionKeys[k];
+			channel.positions.push_back({ static_cast<float>(key.mTime), glm::vec3(key.mValue.x, key.mValue.y, key.mValue.z) });
+		}
+		for (unsigned int k = 0; k < nodeAnim->mNumRotationKeys; k++) {
+			const aiQuatKey& key = nodeAnim->mRotationKeys[k];
+			channel.rotations.push_back({ static_cast<float>(key.mTime), glm::quat(key.mValue.w, key.mValue.x, key.mValue.y, key.mValue.z) });
+		}
+		for (unsigned int k = 0; k < nodeAnim->mNumScalingKeys; k++) {
+			const aiVectorKey& key = nodeAnim->mScalingKeys[k];
+			channel.scales.push_back({ static_cast<float>(key.mTime), glm::vec3(key.mValue.x, key.mValue.y, key.mValue.z) });
+		}
+		clip.channels.push_back(std::move(channel));
+	}
+	return clip;
+}
+
+void buildBindPose(Skeleton& skeleton) {
+	skeleton.bindPose.resize(skeleton.nodes.size());
+	for (size_t i = 0; i < skeleton.nodes.size(); i++) {
+		glm::vec3 translation, scale;
+		glm::quat rotation;
+		decomposeTransform(skeleton.nodes[i].bindLocal, translation, rotation, scale);
+		skeleton.bindPose.set(i, translation, rotation, scale);
+	}
+}
+
+Skeleton buildSkeleton(const aiScene* scene, const ClipCompressionSettings& compression) {
+	Skeleton skeleton;
+	if (!scene || !scene->mRootNode) return skeleton;
+
+	flattenNodes(scene->mRootNode, -1, skeleton.nodes);
+	skeleton.globalInverse = glm::inverse(skeleton.nodes[0].bindLocal);
+
+	// meshes skinned to the same bone share its palette slot
+	for (unsigned int m = 0; m < scene->mNumMeshes; m++) {
+		const aiMesh* mesh = scene->mMeshes[m];
+		for (unsigned int b = 0; b < mesh->mNumBones; b++) {
+			std::string name = mesh->mBones[b]->mName.C_Str();
+			if (skeleton.boneIndex.count(name)) continue;
+
+			skeleton.boneIndex[name] = static_cast<int>(skeleton.boneOffsets.size());
+			skeleton.boneOffsets.push_back(toGlm(mesh->mBones[b]->mOffsetMatrix));
+		}
+	}
+
+	for (SkeletonNode& node : skeleton.nodes) {
+		auto found = skeleton.boneIndex.find(node.name);
+		if (found != skeleton.boneIndex.end()) node.bone = found->second;
+	}
+
+	// clips drive the node locals too, a file without bones can still be animated per node.
+	// The bind pose is what clips are compressed against and what untouched nodes hold
+	if (skeleton.empty() && scene->mNumAnimations == 0) return skeleton;
+	buildBindPose(skeleton);
+
+	// the raw keys are dropped as soon as their clip is compressed
+	size_t rawBytes = 0, compressedBytes = 0;
+	for (unsigned int a = 0; a < scene->mNumAnimations; a++) {
+		AnimationClip clip = loadClip(scene->mAnimations[a], skeleton);
+		rawBytes += rawClipMemory(clip);
+		skeleton.clips.push_back(compressClip(clip, skeleton.bindPose, compression));
+		compressedBytes += skeleton.clips.back().memory();
+	}
+
+	if (!skeleton.clips.empty()) {
+		std::cout << "ANIMATION:: " << skeleton.clips.size() << " clips, " << skeleton.boneCount() << " bones, keys "
+			<< rawBytes << " bytes -> " << compressedBytes << " bytes" << std::endl;
+	}
+	return skeleton;
+}
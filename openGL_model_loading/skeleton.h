@@ -0,0 +1,52 @@
+#ifndef SKELETON_H
+#define SKELETON_H
+
+#include <glm/glm/glm.hpp>
+#include <glm/glm/gtc/quaternion.hpp>
+
+#include <assimp/scene.h>
+
+#include "animation_clip.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// size of the bone palette uniform block, has to match model_vShader.vert.
+// Skeletons with more bones than this are skinned on the CPU
+#define MAX_BONES 100
+
+// one node of the scene hierarchy, stored parents first so globals can be built in a single pass
+struct SkeletonNode {
+	std::string name;
+	int parent;				// index in Skeleton::nodes, -1 for the root
+	glm::mat4 bindLocal;	// transform relative to the parent when no channel animates the node
+	int bone;				// palette slot, -1 when no mesh is skinned to this node
+};
+
+// node hierarchy, bones and animations of a scene. Built once before the meshes are processed,
+// read only afterwards so worker threads and any number of Animators can share it
+struct Skeleton {
+	std::vector<SkeletonNode> nodes;
+	std::vector<glm::mat4> boneOffsets;				// mesh space -> bone space, per palette slot
+	std::unordered_map<std::string, int> boneIndex;	// bone name -> palette slot
+	glm::mat4 globalInverse = glm::mat4(1.0f);		// undoes the root transform, bones end up in mesh space
+	LocalPose bindPose;								// bindLocal of every node split for the clip sampler
+	std::vector<CompressedClip> clips;
+
+	size_t boneCount() const { return boneOffsets.size(); }
+	bool empty() const { return boneOffsets.empty(); }
+	bool animated() const { return !boneOffsets.empty() || !clips.empty(); }	// bones to skin or clips to play
+	int findNode(const std::string& name) const;
+	int findClip(const std::string& name) const;
+};
+
+// collect the hierarchy, every bone any mesh refers to and the compressed animations of the scene
+Skeleton buildSkeleton(const aiScene* scene, const ClipCompressionSettings& compression = ClipCompressionSettings());
+
+// split the nodes' bind transforms into Skeleton::bindPose
+void buildBindPose(Skeleton& skeleton);
+
+glm::mat4 toGlm(const aiMatrix4x4& m);
+
+#endif
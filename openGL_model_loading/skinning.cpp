@@ -0,0 +1,82 @@
+#include "skinning.h"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SKINNING_SSE
+#endif
+
+static glm::vec3 normalizeOrZero(const glm::vec3& v) {
+	float length = std::sqrt(glm::dot(v, v));
+	return length > 0.0f ? v / length : v;
+}
+
+#ifdef SKINNING_SSE
+
+// columns[0] * x + columns[1] * y + columns[2] * z (+ columns[3] for points)
+static inline glm::vec3 transformSSE(const __m128 columns[4], const glm::vec3& v, bool point) {
+	__m128 result = _mm_mul_ps(columns[0], _mm_set1_ps(v.x));
+	result = _mm_add_ps(result, _mm_mul_ps(columns[1], _mm_set1_ps(v.y)));
+	result = _mm_add_ps(result, _mm_mul_ps(columns[2], _mm_set1_ps(v.z)));
+	if (point) result = _mm_add_ps(result, columns[3]);
+
+	float stored[4];
+	_mm_storeu_ps(stored, result);
+	return glm::vec3(stored[0], stored[1], stored[2]);
+}
+
+void skinVertices(const Vertex* bindPose, size_t numVertices, const glm::mat4* palette, size_t numBones, Vertex* out) {
+	for (size_t i = 0; i < numVertices; i++) {
+		const Vertex& vertex = bindPose[i];
+		out[i] = vertex;
+
+		// weighted sum of the bone matrices, one column per register
+		__m128 columns[4] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+		bool weighted = false;
+		for (int j = 0; j < MAX_BONE_INFLUENCE; j++) {
+			int bone = vertex.m_BoneIDs[j];
+			float weight = vertex.m_Weights[j];
+			if (bone < 0 || static_cast<size_t>(bone) >= numBones || weight <= 0.0f) continue;
+
+			const float* matrix = &palette[bone][0][0];
+			__m128 splat = _mm_set1_ps(weight);
+			for (int c = 0; c < 4; c++) columns[c] = _mm_add_ps(columns[c], _mm_mul_ps(_mm_loadu_ps(matrix + c * 4), splat));
+			weighted = true;
+		}
+		if (!weighted) continue;
+
+		out[i].Position = transformSSE(columns, vertex.Position, true);
+		out[i].Normal = normalizeOrZero(transformSSE(columns, vertex.Normal, false));
+		out[i].Tangent = normalizeOrZero(transformSSE(columns, vertex.Tangent, false));
+		out[i].Bitangent = normalizeOrZero(transformSSE(columns, vertex.Bitangent, false));
+	}
+}
+
+#else
+
+void skinVertices(const Vertex* bindPose, size_t numVertices, const glm::mat4* palette, size_t numBones, Vertex* out) {
+	for (size_t i = 0; i < numVertices; i++) {
+		const Vertex& vertex = bindPose[i];
+		out[i] = vertex;
+
+		glm::mat4 skin(0.0f);
+		bool weighted = false;
+		for (int j = 0; j < MAX_BONE_INFLUENCE; j++) {
+			int bone = vertex.m_BoneIDs[j];
+			float weight = vertex.m_Weights[j];
+			if (bone < 0 || static_cast<size_t>(bone) >= numBones || weight <= 0.0f) continue;
+
+			skin = skin + palette[bone] * weight;
+			weighted = true;
+		}
+		if (!weighted) continue;
+
+		out[i].Position = glm::vec3(skin * glm::vec4(vertex.Position, 1.0f));
+		out[i].Normal = normalizeOrZero(glm::vec3(skin * glm::vec4(vertex.Normal, 0.0f)));
+		out[i].Tangent = normalizeOrZero(glm::vec3(skin * glm::vec4(vertex.Tangent, 0.0f)));
+		out[i].Bitangent = normalizeOrZero(glm::vec3(skin * glm::vec4(vertex.Bitangent, 0.0f)));
+	}
+}
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef SKINNING_H
+#define SKINNING_H
+
+#include "mesh_data.h"
+
+// CPU fallback of the vertex shader skinning, for skeletons too big for the palette block or when
+// ModelSettings::cpuSkinning asks for it. Blends up to MAX_BONE_INFLUENCE palette matrices per vertex
+// and transforms position, normal, tangent and bitangent into out, vertices without weights are copied
+// as they are. Uses SSE when the target has it
+void skinVertices(const Vertex* bindPose, size_t numVertices, const glm::mat4* palette, size_t numBones, Vertex* out);
+
+#endif
@@ -0,0 +1,174 @@
+#include "texture_block_cache.h"
+#include "mesh_cache.h"
+#include "thread_pool.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+
+namespace fs = std::filesystem;
+
+static const char TEXTURE_BLOCK_CACHE_MAGIC[4] = { 'T', 'B', 'C', 'C' };
+
+static TextureCompressionStats& counters() {
+	static TextureCompressionStats stats;
+	return stats;
+}
+
+// loads run on the workers, the counters are updated under this
+static std::mutex& countersMutex() {
+	static std::mutex mutex;
+	return mutex;
+}
+
+// one file per source and encoding, the key string is stored in the entry and compared on read
+static std::string encodingKey(const std::string& sourcePath, const TextureEncoding& encoding) {
+	std::string key = cacheSourceKey(sourcePath);
+	key += encoding.normalMap ? "#normal" : "#color";
+	key += "#q" + std::to_string(static_cast<unsigned int>(encoding.quality));
+	if (encoding.allowBC7) key += "#bc7";
+	return key;
+}
+
+bool TextureBlockCache::read(const std::string& sourcePath, const TextureEncoding& encoding, CompressedImage& image) {
+	int64_t mtime;
+	uint64_t size;
+	if (!cacheSourceStat(sourcePath, mtime, size)) return false;
+
+	std::string key = encodingKey(sourcePath, encoding);
+	std::ifstream in(cacheEntryPath(key, ".tcache"), std::ios::binary);
+	if (!in) return false;
+	std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+	TextureBlockCacheHeader header;
+	if (bytes.size() < sizeof(header)) return false;
+	std::memcpy(&header, bytes.data(), sizeof(header));
+
+	if (std::memcmp(header.magic, TEXTURE_BLOCK_CACHE_MAGIC, 4) != 0 || header.version != TEXTURE_BLOCK_CACHE_VERSION) return false;
+	if (header.sourceMtime != mtime || header.sourceSize != size || header.fileSize != bytes.size()) return false;
+	if (!validBlockFormat(header.format)) return false;
+	if (cacheHash(bytes.data() + sizeof(header), bytes.size() - sizeof(header)) != header.payloadHash) return false;
+
+	size_t cursor = sizeof(header);
+	uint32_t keyLength;
+	if (cursor + sizeof(keyLength) > bytes.size()) return false;
+	std::memcpy(&keyLength, bytes.data() + cursor, sizeof(keyLength));
+	cursor += sizeof(keyLength);
+	if (keyLength > bytes.size() - cursor || key.compare(0, std::string::npos, reinterpret_cast<const char*>(bytes.data() + cursor), keyLength) != 0) return false;
+	cursor += keyLength;
+
+	CompressedImage loaded;
+	loaded.format = static_cast<BlockFormat>(header.format);
+	if (header.mipCount > (bytes.size() - cursor) / sizeof(CompressedMip)) return false;
+	loaded.mips.resize(header.mipCount);
+	if (header.mipCount > 0) std::memcpy(loaded.mips.data(), bytes.data() + cursor, header.mipCount * sizeof(CompressedMip));
+	cursor += header.mipCount * sizeof(CompressedMip);
+
+	loaded.pixels.assign(bytes.begin() + cursor, bytes.end());
+	for (const CompressedMip& mip : loaded.mips) {
+		uint64_t expected = loaded.format == BLOCK_FORMAT_NONE ? uint64_t(mip.width) * mip.height * 4 : compressedSize(loaded.format, mip.width, mip.height);
+		if (mip.width == 0 || mip.height == 0 || mip.bytes != expected || mip.offset + mip.bytes > loaded.pixels.size()) return false;
+	}
+
+	image = std::move(loaded);
+	return true;
+}
+
+bool TextureBlockCache::write(const std::string& sourcePath, const TextureEncoding& encoding, const CompressedImage& image) {
+	TextureBlockCacheHeader header{};
+	std::memcpy(header.magic, TEXTURE_BLOCK_CACHE_MAGIC, 4);
+	header.version = TEXTURE_BLOCK_CACHE_VERSION;
+	header.format = image.format;
+	header.mipCount = static_cast<uint32_t>(image.mips.size());
+	if (!cacheSourceStat(sourcePath, header.sourceMtime, header.sourceSize)) return false;
+
+	std::string key = encodingKey(sourcePath, encoding);
+	uint32_t keyLength = static_cast<uint32_t>(key.size());
+
+	std::vector<unsigned char> bytes(sizeof(header) + sizeof(keyLength) + key.size() + image.mips.size() * sizeof(CompressedMip) + image.pixels.size());
+	unsigned char* cursor = bytes.data() + sizeof(header);	// header filled in once the payload is hashed
+	std::memcpy(cursor, &keyLength, sizeof(keyLength));
+	cursor += sizeof(keyLength);
+	std::memcpy(cursor, key.data(), key.size());
+	cursor += key.size();
+	if (!image.mips.empty()) std::memcpy(cursor, image.mips.data(), image.mips.size() * sizeof(CompressedMip));
+	cursor += image.mips.size() * sizeof(CompressedMip);
+	if (!image.pixels.empty()) std::memcpy(cursor, image.pixels.data(), image.pixels.size());
+
+	header.fileSize = bytes.size();
+	header.payloadHash = cacheHash(bytes.data() + sizeof(header), bytes.size() - sizeof(header));
+	std::memcpy(bytes.data(), &header, sizeof(header));
+
+	std::error_code ec;
+	fs::create_directories(MESH_CACHE_DIR, ec);
+
+	std::string cachePath = cacheEntryPath(key, ".tcache");
+	std::string tempPath = cachePath + ".tmp";
+	{
+		std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+		out.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+		if (!out) {
+			std::cout << "ERROR::TEXTURE_BLOCK_CACHE::WRITE_FAILED: " << tempPath << std::endl;
+			return false;
+		}
+	}
+
+	fs::rename(tempPath, cachePath, ec);
+	if (ec) {
+		std::cout << "ERROR::TEXTURE_BLOCK_CACHE::WRITE_FAILED: " << ec.message() << std::endl;
+		fs::remove(tempPath, ec);
+		return false;
+	}
+	return true;
+}
+
+CompressedImage TextureBlockCache::load(const std::string& sourcePath, const DecodedImageFuture& decode, const TextureEncoding& encoding, bool useCache) {
+	CompressedImage image;
+	bool hit = useCache && read(sourcePath, encoding, image);
+	double milliseconds = 0.0;
+	if (!hit) {
+		auto start = std::chrono::steady_clock::now();
+		std::shared_ptr<DecodedImage> decoded = decode.valid() ? decode.get() : decodeImage(sourcePath);
+		image = compressImage(*decoded, encoding.normalMap, encoding.quality, encoding.allowBC7);
+		if (image.mips.empty()) return image;
+
+		milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		if (useCache) write(sourcePath, encoding, image);
+	}
+
+	std::lock_guard<std::mutex> lock(countersMutex());
+	TextureCompressionStats& stats = counters();
+	if (hit) stats.cacheHits++;
+	else {
+		stats.encoded++;
+		stats.encodeMilliseconds += milliseconds;
+	}
+	stats.uncompressedBytes += image.uncompressedBytes();
+	stats.compressedBytes += image.pixels.size();
+	return image;
+}
+
+CompressedImageFuture TextureBlockCache::loadAsync(const std::string& sourcePath, const DecodedImageFuture& decode, const TextureEncoding& encoding, bool useCache) {
+	// the pool is FIFO, the decode was queued first so it is running or done by the time this waits on it
+	return ThreadPool::shared().submit([sourcePath, decode, encoding, useCache]() {
+		return std::make_shared<CompressedImage>(load(sourcePath, decode, encoding, useCache));
+	}).share();
+}
+
+const TextureCompressionStats& TextureBlockCache::stats() {
+	return counters();
+}
+
+void TextureBlockCache::printStats() {
+	std::lock_guard<std::mutex> lock(countersMutex());
+	const TextureCompressionStats& stats = counters();
+	if (stats.encoded + stats.cacheHits == 0) return;
+
+	double ratio = stats.compressedBytes > 0 ? static_cast<double>(stats.uncompressedBytes) / stats.compressedBytes : 0.0;
+	std::cout << "TEXTURE_COMPRESSION:: encoded " << stats.encoded << " in " << stats.encodeMilliseconds << " ms, cached " << stats.cacheHits
+		<< ", " << stats.uncompressedBytes / 1024 << " KB -> " << stats.compressedBytes / 1024 << " KB (" << ratio << "x)" << std::endl;
+}
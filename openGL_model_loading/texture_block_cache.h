@@ -0,0 +1,59 @@
+#ifndef TEXTURE_BLOCK_CACHE_H
+#define TEXTURE_BLOCK_CACHE_H
+
+#include "block_compress.h"
+#include "texture_loader.h"
+
+#include <cstdint>
+#include <string>
+
+// Block compressed mip chains of image files, kept in the mesh cache directory so a texture is
+// encoded once. An entry belongs to one file and one encoding, it is dropped when the file's
+// size or time stamp changes
+#define TEXTURE_BLOCK_CACHE_VERSION 1
+
+struct TextureBlockCacheHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t format;		// BlockFormat
+	uint32_t mipCount;
+	int64_t sourceMtime;
+	uint64_t sourceSize;
+	uint64_t fileSize;
+	uint64_t payloadHash;	// everything after the header: source path, mips, pixels
+};
+
+// what the encoder is asked for, part of the cache key
+struct TextureEncoding {
+	bool normalMap = false;
+	CompressionQuality quality = COMPRESSION_NORMAL;
+	bool allowBC7 = false;
+};
+
+// textures loaded through TextureBlockCache::load so far
+struct TextureCompressionStats {
+	unsigned int encoded = 0;
+	unsigned int cacheHits = 0;
+	size_t uncompressedBytes = 0;	// RGBA8 chains of the same textures
+	size_t compressedBytes = 0;
+	double encodeMilliseconds = 0.0;
+};
+
+class TextureBlockCache {
+public:
+	// the cached chain of sourcePath, false on a miss or a stale or damaged entry
+	static bool read(const std::string& sourcePath, const TextureEncoding& encoding, CompressedImage& image);
+	static bool write(const std::string& sourcePath, const TextureEncoding& encoding, const CompressedImage& image);
+
+	// the cached chain, or decode, encode and cache it on a miss. A decode already queued for the file
+	// is used when there is one. No mips when the file can't be decoded
+	static CompressedImage load(const std::string& sourcePath, const DecodedImageFuture& decode, const TextureEncoding& encoding, bool useCache = true);
+
+	// load on the shared worker pool, queued behind the decode it waits for. The GL thread only uploads the result
+	static CompressedImageFuture loadAsync(const std::string& sourcePath, const DecodedImageFuture& decode, const TextureEncoding& encoding, bool useCache = true);
+
+	static const TextureCompressionStats& stats();
+	static void printStats();
+};
+
+#endif
@@ -0,0 +1,56 @@
+#include "texture_cache.h"
+#include "texture_residency.h"
+
+#include <glad/glad.h>
+
+#include <filesystem>
+#include <iostream>
+
+TextureCache& TextureCache::shared() {
+	static TextureCache cache;
+	return cache;
+}
+
+std::string TextureCache::canonicalPath(const std::string& path) {
+	std::error_code ec;
+	std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+	if (ec) return std::filesystem::path(path).lexically_normal().generic_string();
+	return canonical.generic_string();
+}
+
+unsigned int TextureCache::acquire(const std::string& key, const std::function<unsigned int()>& load) {
+	auto found = entries.find(key);
+	if (found != entries.end()) {
+		counters.hits++;
+		found->second.refCount++;
+		return found->second.id;
+	}
+
+	counters.misses++;
+	counters.resident++;
+
+	Entry entry;
+	entry.id = load();
+	entry.refCount = 1;
+	entries.emplace(key, entry);
+	return entry.id;
+}
+
+void TextureCache::release(const std::string& key) {
+	auto found = entries.find(key);
+	if (found == entries.end()) return;
+
+	if (--found->second.refCount == 0) {
+		TextureResidency::shared().forget(found->second.id);
+		glDeleteTextures(1, &found->second.id);
+		entries.erase(found);
+
+		counters.released++;
+		counters.resident--;
+	}
+}
+
+void TextureCache::printStats() const {
+	std::cout << "TEXTURE_CACHE:: hits " << counters.hits << ", misses " << counters.misses
+		<< ", resident " << counters.resident << ", released " << counters.released << std::endl;
+}
@@ -0,0 +1,87 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+struct TextureCacheStats {
+	unsigned int hits = 0;
+	unsigned int misses = 0;
+	unsigned int released = 0;	// textures deleted after their last reference went away
+	unsigned int resident = 0;
+};
+
+// Process wide cache of GL textures keyed by canonical file path plus how the file is encoded,
+// Models that share a texture decode and upload it only once. GL thread only
+class TextureCache {
+public:
+	static TextureCache& shared();
+
+	// canonical form of a texture path, the start of every cache key
+	static std::string canonicalPath(const std::string& path);
+
+	// add a reference to the texture stored under key, load() creates it on a miss
+	unsigned int acquire(const std::string& key, const std::function<unsigned int()>& load);
+
+	bool contains(const std::string& key) const { return entries.count(key) != 0; }
+
+	// drop a reference, the GL texture is deleted together with the last one
+	void release(const std::string& key);
+
+	const TextureCacheStats& stats() const { return counters; }
+	void printStats() const;
+
+private:
+	struct Entry {
+		unsigned int id;
+		unsigned int refCount;
+	};
+
+	std::unordered_map<std::string, Entry> entries;
+	TextureCacheStats counters;
+};
+
+// one counted reference on a cached texture, released when the handle is destroyed
+class TextureHandle {
+public:
+	TextureHandle() {}
+	TextureHandle(const std::string& key, const std::function<unsigned int()>& load)
+		: cacheKey(key), textureID(TextureCache::shared().acquire(key, load)) {}
+
+	~TextureHandle() { reset(); }
+
+	TextureHandle(const TextureHandle&) = delete;
+	TextureHandle& operator=(const TextureHandle&) = delete;
+
+	TextureHandle(TextureHandle&& other) noexcept : cacheKey(std::move(other.cacheKey)), textureID(other.textureID) {
+		other.cacheKey.clear();
+		other.textureID = 0;
+	}
+
+	TextureHandle& operator=(TextureHandle&& other) noexcept {
+		if (this != &other) {
+			reset();
+			cacheKey = std::move(other.cacheKey);
+			textureID = other.textureID;
+			other.cacheKey.clear();
+			other.textureID = 0;
+		}
+		return *this;
+	}
+
+	unsigned int id() const { return textureID; }
+
+	void reset() {
+		if (!cacheKey.empty()) TextureCache::shared().release(cacheKey);
+		cacheKey.clear();
+		textureID = 0;
+	}
+
+private:
+	std::string cacheKey;
+	unsigned int textureID = 0;
+};
+
+#endif
@@ -0,0 +1,199 @@
+#include "texture_loader.h"
+#include "gl_extensions.h"
+#include "thread_pool.h"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <iostream>
+
+DecodedImage::~DecodedImage() {
+	if (pixels) stbi_image_free(pixels);
+}
+
+std::shared_ptr<DecodedImage> decodeImage(const std::string& path, bool flipVertically) {
+	std::shared_ptr<DecodedImage> image = std::make_shared<DecodedImage>();
+	image->path = path;
+
+	// the flip flag is per thread so concurrent decodes don't fight over it
+	stbi_set_flip_vertically_on_load_thread(flipVertically);
+	image->pixels = stbi_load(path.c_str(), &image->width, &image->height, &image->channels, 0);
+	return image;
+}
+
+DecodedImageFuture decodeImageAsync(const std::string& path, bool flipVertically) {
+	return ThreadPool::shared().submit([path, flipVertically]() { return decodeImage(path, flipVertically); }).share();
+}
+
+unsigned int uploadImageTexture(const DecodedImage& image, const TextureSampling& sampling) {
+	unsigned int textureID;
+	glGenTextures(1, &textureID);
+
+	if (image.pixels) {
+		GLenum format = GL_RGB;
+		if (image.channels == 1) format = GL_RED;
+		else if (image.channels == 3) format = GL_RGB;
+		else if (image.channels == 4) format = GL_RGBA;
+
+		glBindTexture(GL_TEXTURE_2D, textureID);
+
+		glTexImage2D(GL_TEXTURE_2D, 0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, image.pixels);
+		glGenerateMipmap(GL_TEXTURE_2D);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, sampling.wrap);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, sampling.wrap);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, sampling.minFilter);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, sampling.magFilter);
+	}
+	else {
+		std::cout << "Texture load unsuccesfully at: " << image.path << std::endl;
+	}
+
+	return textureID;
+}
+
+std::vector<MipLevel> buildMipChain(const DecodedImage& image) {
+	std::vector<MipLevel> levels;
+	if (!image.pixels || image.width <= 0 || image.height <= 0) return levels;
+
+	// grey and grey alpha images spread over RGB so every level has the same layout
+	MipLevel base;
+	base.width = image.width;
+	base.height = image.height;
+	base.pixels.resize(static_cast<size_t>(image.width) * image.height * 4);
+	for (size_t i = 0; i < static_cast<size_t>(image.width) * image.height; i++) {
+		const unsigned char* in = image.pixels + i * image.channels;
+		unsigned char* out = base.pixels.data() + i * 4;
+		if (image.channels < 3) {
+			out[0] = out[1] = out[2] = in[0];
+			out[3] = image.channels == 2 ? in[1] : 255;
+		}
+		else {
+			out[0] = in[0];
+			out[1] = in[1];
+			out[2] = in[2];
+			out[3] = image.channels == 4 ? in[3] : 255;
+		}
+	}
+	levels.push_back(std::move(base));
+
+	// 2x2 box filter, odd sizes reuse their last row or column
+	while (levels.back().width > 1 || levels.back().height > 1) {
+		const MipLevel& source = levels.back();
+		MipLevel next;
+		next.width = std::max(source.width / 2, 1);
+		next.height = std::max(source.height / 2, 1);
+		next.pixels.resize(static_cast<size_t>(next.width) * next.height * 4);
+
+		for (int y = 0; y < next.height; y++) {
+			int y0 = std::min(y * 2, source.height - 1), y1 = std::min(y * 2 + 1, source.height - 1);
+			for (int x = 0; x < next.width; x++) {
+				int x0 = std::min(x * 2, source.width - 1), x1 = std::min(x * 2 + 1, source.width - 1);
+				const unsigned char* p00 = source.pixels.data() + (static_cast<size_t>(y0) * source.width + x0) * 4;
+				const unsigned char* p01 = source.pixels.data() + (static_cast<size_t>(y0) * source.width + x1) * 4;
+				const unsigned char* p10 = source.pixels.data() + (static_cast<size_t>(y1) * source.width + x0) * 4;
+				const unsigned char* p11 = source.pixels.data() + (static_cast<size_t>(y1) * source.width + x1) * 4;
+				unsigned char* out = next.pixels.data() + (static_cast<size_t>(y) * next.width + x) * 4;
+				for (int c = 0; c < 4; c++) out[c] = static_cast<unsigned char>((p00[c] + p01[c] + p10[c] + p11[c] + 2) / 4);
+			}
+		}
+		levels.push_back(std::move(next));
+	}
+	return levels;
+}
+
+bool hasTransparency(const MipLevel& level) {
+	for (size_t i = 3; i < level.pixels.size(); i += 4) {
+		if (level.pixels[i] != 255) return true;
+	}
+	return false;
+}
+
+CompressedImage compressMipChain(const std::vector<MipLevel>& levels, BlockFormat format, CompressionQuality quality) {
+	CompressedImage image;
+	image.format = format;
+
+	size_t total = 0;
+	for (const MipLevel& level : levels) {
+		total += format == BLOCK_FORMAT_NONE ? level.pixels.size() : compressedSize(format, level.width, level.height);
+	}
+	image.pixels.resize(total);
+
+	for (const MipLevel& level : levels) {
+		CompressedMip mip;
+		mip.offset = image.mips.empty() ? 0 : image.mips.back().offset + image.mips.back().bytes;
+		mip.bytes = format == BLOCK_FORMAT_NONE ? level.pixels.size() : compressedSize(format, level.width, level.height);
+		mip.width = level.width;
+		mip.height = level.height;
+
+		if (format == BLOCK_FORMAT_NONE) std::copy(level.pixels.begin(), level.pixels.end(), image.pixels.begin() + mip.offset);
+		else compressBlocks(format, level.pixels.data(), level.width, level.height, image.pixels.data() + mip.offset, quality);
+		image.mips.push_back(mip);
+	}
+	return image;
+}
+
+CompressedImage compressImage(const DecodedImage& image, bool normalMap, CompressionQuality quality, bool allowBC7) {
+	std::vector<MipLevel> levels = buildMipChain(image);
+	if (levels.empty()) return CompressedImage();
+	return compressMipChain(levels, chooseBlockFormat(normalMap, hasTransparency(levels[0]), quality, allowBC7), quality);
+}
+
+bool blockFormatSupported(BlockFormat format) {
+	switch (format) {
+	case BLOCK_FORMAT_BC1:
+	case BLOCK_FORMAT_BC3: return glExtensions().textureCompressionS3TC;
+	case BLOCK_FORMAT_BC7: return glExtensions().textureCompressionBPTC;
+	default: return true;
+	}
+}
+
+void specifyTextureLevels(unsigned int textureID, const TextureLevel* levels, size_t count, BlockFormat format) {
+	glBindTexture(GL_TEXTURE_2D, textureID);
+	bool compressed = format != BLOCK_FORMAT_NONE;
+	bool decode = compressed && !blockFormatSupported(format);
+
+	std::vector<unsigned char> decoded;
+	for (size_t i = 0; i < count; i++) {
+		const TextureLevel& level = levels[i];
+		GLint mip = static_cast<GLint>(i);
+		if (decode) {
+			decoded.resize(static_cast<size_t>(level.width) * level.height * 4);
+			decompressBlocks(format, level.data, level.width, level.height, decoded.data());
+			glTexImage2D(GL_TEXTURE_2D, mip, GL_RGBA8, level.width, level.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, decoded.data());
+		}
+		else if (compressed) {
+			glCompressedTexImage2D(GL_TEXTURE_2D, mip, blockInternalFormat(format), level.width, level.height, 0, static_cast<GLsizei>(level.bytes), level.data);
+		}
+		else glTexImage2D(GL_TEXTURE_2D, mip, GL_RGBA8, level.width, level.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, level.data);
+	}
+	// a chain that stops before 1x1 is still complete
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(count - 1));
+}
+
+unsigned int uploadTextureLevels(const TextureLevel* levels, size_t count, BlockFormat format, const TextureSampling& sampling) {
+	unsigned int textureID;
+	glGenTextures(1, &textureID);
+	if (count == 0) return textureID;
+
+	specifyTextureLevels(textureID, levels, count, format);
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, sampling.wrap);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, sampling.wrap);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, sampling.minFilter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, sampling.magFilter);
+	return textureID;
+}
+
+std::vector<TextureLevel> imageLevels(const CompressedImage& image) {
+	std::vector<TextureLevel> levels;
+	for (const CompressedMip& mip : image.mips) {
+		levels.push_back({ image.pixels.data() + mip.offset, static_cast<size_t>(mip.bytes), static_cast<int>(mip.width), static_cast<int>(mip.height) });
+	}
+	return levels;
+}
+
+unsigned int uploadCompressedImage(const CompressedImage& image, const TextureSampling& sampling) {
+	std::vector<TextureLevel> levels = imageLevels(image);
+	return uploadTextureLevels(levels.data(), levels.size(), image.format, sampling);
+}
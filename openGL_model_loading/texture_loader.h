@@ -0,0 +1,90 @@
+#ifndef TEXTURE_LOADER_H
+#define TEXTURE_LOADER_H
+
+#include <glad/glad.h>
+
+#include "block_compress.h"
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+// pixels decoded by stb_image, freed together with the object
+struct DecodedImage {
+	std::string path;
+	unsigned char* pixels = nullptr;
+	int width = 0;
+	int height = 0;
+	int channels = 0;
+
+	DecodedImage() {}
+	~DecodedImage();
+
+	DecodedImage(const DecodedImage&) = delete;
+	DecodedImage& operator=(const DecodedImage&) = delete;
+};
+
+typedef std::shared_future<std::shared_ptr<DecodedImage>> DecodedImageFuture;
+typedef std::shared_future<std::shared_ptr<CompressedImage>> CompressedImageFuture;
+
+// sampling state applied when the decoded pixels are uploaded
+struct TextureSampling {
+	GLint wrap = GL_REPEAT;
+	GLint minFilter = GL_NEAREST;
+	GLint magFilter = GL_NEAREST;
+};
+
+// decode an image file on the calling thread, any thread is fine
+std::shared_ptr<DecodedImage> decodeImage(const std::string& path, bool flipVertically = false);
+
+// queue the decode on the shared worker pool, the GL thread picks the pixels up with get()
+DecodedImageFuture decodeImageAsync(const std::string& path, bool flipVertically = false);
+
+// create a mipmapped GL texture from decoded pixels, GL thread only.
+// A texture name is returned even when decoding failed, like the old loaders did
+unsigned int uploadImageTexture(const DecodedImage& image, const TextureSampling& sampling = TextureSampling());
+
+// one level of a mip chain built on the CPU
+struct MipLevel {
+	int width = 0;
+	int height = 0;
+	std::vector<unsigned char> pixels;	// RGBA8, or blocks once compressed
+};
+
+// expand the decoded pixels to RGBA8 and box filter them down to 1x1, level 0 is the full image
+std::vector<MipLevel> buildMipChain(const DecodedImage& image);
+
+// any pixel with alpha below 255
+bool hasTransparency(const MipLevel& level);
+
+// encode every level of a chain into one buffer, format NONE copies the RGBA8 pixels
+CompressedImage compressMipChain(const std::vector<MipLevel>& levels, BlockFormat format, CompressionQuality quality);
+
+// mip chain and block compression of a decoded image in the format chooseBlockFormat picks for it,
+// no mips when the decode failed
+CompressedImage compressImage(const DecodedImage& image, bool normalMap, CompressionQuality quality, bool allowBC7);
+
+// a prebuilt level in memory the caller owns, e.g. a mapped package
+struct TextureLevel {
+	const unsigned char* data;
+	size_t bytes;
+	int width;
+	int height;
+};
+
+// create a texture from a prebuilt mip chain, block compressed levels are uploaded as they are
+// or decoded first when the driver lacks the format. GL thread only
+unsigned int uploadTextureLevels(const TextureLevel* levels, size_t count, BlockFormat format, const TextureSampling& sampling = TextureSampling());
+unsigned int uploadCompressedImage(const CompressedImage& image, const TextureSampling& sampling = TextureSampling());
+
+// (re)define levels 0 to count - 1 of an existing texture and clamp its max level, sampling state is kept
+void specifyTextureLevels(unsigned int textureID, const TextureLevel* levels, size_t count, BlockFormat format);
+
+// the levels of a chain pointing into its pixels
+std::vector<TextureLevel> imageLevels(const CompressedImage& image);
+
+// whether the driver samples the format directly, RGTC is core since 3.0
+bool blockFormatSupported(BlockFormat format);
+
+#endif
@@ -0,0 +1,204 @@
+#include "texture_residency.h"
+#include "thread_pool.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <utility>
+
+TextureResidency& TextureResidency::shared() {
+	static TextureResidency residency;
+	return residency;
+}
+
+void TextureResidency::track(unsigned int textureID, BlockFormat format, const TextureLevel* levels, size_t count, TextureChainSource source) {
+	if (!enabled() || count == 0) return;
+	forget(textureID);
+
+	// sizes are counted in the format GL keeps, a decoded fallback costs RGBA8
+	Entry entry;
+	entry.format = blockFormatSupported(format) ? format : BLOCK_FORMAT_NONE;
+	for (size_t i = 0; i < count; i++) {
+		size_t bytes = entry.format == BLOCK_FORMAT_NONE ? static_cast<size_t>(levels[i].width) * levels[i].height * 4 : compressedSize(entry.format, levels[i].width, levels[i].height);
+		entry.levels.push_back({ levels[i].width, levels[i].height, bytes });
+	}
+	entry.lastUsed = frame;
+	entry.source = std::move(source);
+
+	residentBytes += levelBytes(entry, 0);
+	entries.emplace(textureID, std::move(entry));
+}
+
+void TextureResidency::track(unsigned int textureID, const CompressedImage& image, TextureChainSource source) {
+	std::vector<TextureLevel> levels = imageLevels(image);
+	track(textureID, image.format, levels.data(), levels.size(), std::move(source));
+}
+
+void TextureResidency::pin(unsigned int textureID, size_t bytes) {
+	if (!enabled() || bytes == 0) return;
+	forget(textureID);
+
+	// a single level and no source, so it is never picked for eviction or restored
+	Entry entry;
+	entry.format = BLOCK_FORMAT_NONE;
+	entry.levels.push_back({ 0, 0, bytes });
+	entry.lastUsed = frame;
+
+	residentBytes += bytes;
+	entries.emplace(textureID, std::move(entry));
+}
+
+void TextureResidency::forget(unsigned int textureID) {
+	auto found = entries.find(textureID);
+	if (found == entries.end()) return;
+
+	// a restore still running on a worker finishes into a future nobody reads
+	Entry& entry = found->second;
+	if (entry.restore.valid()) reservedBytes -= levelBytes(entry, entry.restoreTo) - levelBytes(entry, entry.dropped);
+	residentBytes -= levelBytes(entry, entry.dropped);
+	entries.erase(found);
+}
+
+unsigned int TextureResidency::droppedLevels(unsigned int textureID) const {
+	auto found = entries.find(textureID);
+	return found != entries.end() ? found->second.dropped : 0;
+}
+
+void TextureResidency::touch(unsigned int textureID) {
+	if (entries.empty()) return;
+	auto found = entries.find(textureID);
+	if (found != entries.end()) found->second.lastUsed = frame;
+}
+
+size_t TextureResidency::levelBytes(const Entry& entry, unsigned int first) const {
+	size_t bytes = 0;
+	for (size_t i = first; i < entry.levels.size(); i++) bytes += entry.levels[i].bytes;
+	return bytes;
+}
+
+bool TextureResidency::canDrop(const Entry& entry, unsigned int dropped) const {
+	if (dropped + 1 >= entry.levels.size()) return false;
+	const Level& top = entry.levels[dropped];
+	return std::max(top.width, top.height) > minResidentSize;
+}
+
+// the levels that stay are read back and moved up, they are a fraction of what is dropped
+void TextureResidency::evict(unsigned int textureID, Entry& entry, unsigned int dropped) {
+	size_t oldCount = entry.levels.size() - entry.dropped;
+	size_t newCount = entry.levels.size() - dropped;
+
+	glBindTexture(GL_TEXTURE_2D, textureID);
+	std::vector<std::vector<unsigned char>> kept(newCount);
+	std::vector<TextureLevel> levels(newCount);
+	for (size_t i = 0; i < newCount; i++) {
+		const Level& level = entry.levels[dropped + i];
+		GLint from = static_cast<GLint>(dropped - entry.dropped + i);
+		kept[i].resize(level.bytes);
+		if (entry.format == BLOCK_FORMAT_NONE) glGetTexImage(GL_TEXTURE_2D, from, GL_RGBA, GL_UNSIGNED_BYTE, kept[i].data());
+		else glGetCompressedTexImage(GL_TEXTURE_2D, from, kept[i].data());
+		levels[i] = { kept[i].data(), level.bytes, level.width, level.height };
+	}
+	specifyTextureLevels(textureID, levels.data(), newCount, entry.format);
+
+	// the old smallest levels now sit past the max level, empty them so their memory goes too
+	for (size_t i = newCount; i < oldCount; i++) {
+		glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), GL_RGBA8, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	}
+
+	residentBytes -= levelBytes(entry, entry.dropped) - levelBytes(entry, dropped);
+	counters.evictedLevels += dropped - entry.dropped;
+	entry.dropped = dropped;
+}
+
+void TextureResidency::finishRestore(unsigned int textureID, Entry& entry) {
+	CompressedImage image = entry.restore.get();
+	reservedBytes -= levelBytes(entry, entry.restoreTo) - levelBytes(entry, entry.dropped);
+
+	// the file may have changed since the texture was created, then it stays as it is
+	bool matches = image.mips.size() == entry.levels.size() && (blockFormatSupported(image.format) ? image.format : BLOCK_FORMAT_NONE) == entry.format;
+	for (size_t i = 0; matches && i < image.mips.size(); i++) {
+		matches = static_cast<int>(image.mips[i].width) == entry.levels[i].width && static_cast<int>(image.mips[i].height) == entry.levels[i].height;
+	}
+	if (!matches) {
+		std::cout << "ERROR::TEXTURE_RESIDENCY::SOURCE_CHANGED: texture " << textureID << " keeps its reduced levels" << std::endl;
+		entry.source = TextureChainSource();
+		return;
+	}
+
+	std::vector<TextureLevel> levels = imageLevels(image);
+	specifyTextureLevels(textureID, levels.data() + entry.restoreTo, levels.size() - entry.restoreTo, image.format);
+
+	residentBytes += levelBytes(entry, entry.restoreTo) - levelBytes(entry, entry.dropped);
+	counters.restoredLevels += entry.dropped - entry.restoreTo;
+	entry.dropped = entry.restoreTo;
+}
+
+void TextureResidency::endFrame() {
+	counters.evictedLevels = 0;
+	counters.restoredLevels = 0;
+
+	for (auto& tracked : entries) {
+		Entry& entry = tracked.second;
+		if (entry.restore.valid() && entry.restore.wait_for(std::chrono::seconds(0)) == std::future_status::ready) finishRestore(tracked.first, entry);
+	}
+
+	// least recently drawn first, a texture loses as many levels as it takes to get under the budget
+	if (residentBytes + reservedBytes > budgetBytes) {
+		std::vector<std::pair<uint64_t, unsigned int>> idle;
+		for (auto& tracked : entries) {
+			const Entry& entry = tracked.second;
+			if (entry.source && !entry.restore.valid() && frame - entry.lastUsed >= minIdleFrames && canDrop(entry, entry.dropped)) {
+				idle.push_back({ entry.lastUsed, tracked.first });
+			}
+		}
+		std::sort(idle.begin(), idle.end());
+
+		for (const auto& candidate : idle) {
+			size_t total = residentBytes + reservedBytes;
+			if (total <= budgetBytes) break;
+
+			Entry& entry = entries[candidate.second];
+			unsigned int dropped = entry.dropped;
+			while (total > budgetBytes && canDrop(entry, dropped)) total -= entry.levels[dropped++].bytes;
+			evict(candidate.second, entry, dropped);
+		}
+	}
+
+	// reduced textures drawn this frame get back as many levels as the budget allows
+	for (auto& tracked : entries) {
+		Entry& entry = tracked.second;
+		if (entry.dropped == 0 || entry.lastUsed != frame || entry.restore.valid() || !entry.source) continue;
+
+		size_t current = levelBytes(entry, entry.dropped);
+		for (unsigned int to = 0; to < entry.dropped; to++) {
+			size_t extra = levelBytes(entry, to) - current;
+			if (residentBytes + reservedBytes + extra > budgetBytes) continue;
+
+			entry.restoreTo = to;
+			entry.restore = ThreadPool::shared().submit(entry.source);
+			reservedBytes += extra;
+			break;
+		}
+	}
+
+	counters.budget = budgetBytes;
+	counters.residentBytes = residentBytes;
+	counters.fullBytes = 0;
+	counters.textures = static_cast<unsigned int>(entries.size());
+	counters.reduced = 0;
+	for (const auto& tracked : entries) {
+		counters.fullBytes += levelBytes(tracked.second, 0);
+		if (tracked.second.dropped > 0) counters.reduced++;
+	}
+	counters.totalEvictedLevels += counters.evictedLevels;
+	counters.totalRestoredLevels += counters.restoredLevels;
+	frame++;
+}
+
+void TextureResidency::printStats() const {
+	std::cout << "TEXTURE_RESIDENCY:: resident " << counters.residentBytes / 1024 << " KB of " << counters.fullBytes / 1024 << " KB, budget " << counters.budget / 1024
+		<< " KB, reduced " << counters.reduced << " of " << counters.textures << " textures, evicted " << counters.evictedLevels << " levels (" << counters.totalEvictedLevels
+		<< " total), restored " << counters.restoredLevels << " (" << counters.totalRestoredLevels << " total)" << std::endl;
+}
@@ -0,0 +1,102 @@
+#ifndef TEXTURE_RESIDENCY_H
+#define TEXTURE_RESIDENCY_H
+
+#include "block_compress.h"
+#include "texture_loader.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <unordered_map>
+#include <vector>
+
+// rebuilds the full chain a texture was created from, runs on a worker thread
+typedef std::function<CompressedImage()> TextureChainSource;
+
+// state of the last finished frame
+struct TextureResidencyStats {
+	size_t budget = 0;
+	size_t residentBytes = 0;		// levels on the GPU now
+	size_t fullBytes = 0;			// with every level of every texture
+	unsigned int textures = 0;
+	unsigned int reduced = 0;		// textures with top levels dropped
+	unsigned int evictedLevels = 0;	// this frame
+	unsigned int restoredLevels = 0;
+	unsigned int totalEvictedLevels = 0;
+	unsigned int totalRestoredLevels = 0;
+};
+
+// Keeps the texture memory of tracked textures under a byte budget. Textures the draw path hasn't
+// touched for a while lose their largest mip levels, least recently used first, and get them back
+// once they are drawn again and the budget has room. The texture names never change, only the
+// levels behind them are re-specified. GL thread only
+class TextureResidency {
+public:
+	static TextureResidency& shared();
+
+	// 0 turns tracking off, textures created while it is off are never tracked
+	void setBudget(size_t bytes) { budgetBytes = bytes; }
+	size_t budget() const { return budgetBytes; }
+	bool enabled() const { return budgetBytes > 0; }
+
+	// frames a texture has to go undrawn before it can lose levels, keeps drawn textures from bouncing
+	void setMinIdleFrames(unsigned int frames) { minIdleFrames = frames; }
+	// levels at or below this size are never dropped
+	void setMinResidentSize(int size) { minResidentSize = size; }
+
+	// start tracking a texture just created from levels in format, source gives the same chain back later
+	void track(unsigned int textureID, BlockFormat format, const TextureLevel* levels, size_t count, TextureChainSource source);
+	void track(unsigned int textureID, const CompressedImage& image, TextureChainSource source);
+	// count a texture that never loses levels toward the budget, e.g. a texture array. The tracked
+	// textures are reduced to make room for it
+	void pin(unsigned int textureID, size_t bytes);
+	// the texture was deleted
+	void forget(unsigned int textureID);
+
+	// top levels of a tracked texture not on the GPU right now, 0 for full and untracked textures
+	unsigned int droppedLevels(unsigned int textureID) const;
+
+	// called where textures are bound for drawing
+	void touch(unsigned int textureID);
+
+	// once per frame after drawing: upload finished restores, evict down to the budget and
+	// queue restores for reduced textures that were drawn
+	void endFrame();
+
+	const TextureResidencyStats& stats() const { return counters; }
+	void printStats() const;
+
+private:
+	struct Level {
+		int width;
+		int height;
+		size_t bytes;
+	};
+
+	struct Entry {
+		BlockFormat format;				// as stored by GL, NONE when the driver needed the blocks decoded
+		std::vector<Level> levels;		// the full chain
+		unsigned int dropped = 0;		// top levels currently not on the GPU
+		uint64_t lastUsed = 0;
+		TextureChainSource source;		// cleared when it stops matching the chain
+		std::future<CompressedImage> restore;
+		unsigned int restoreTo = 0;		// dropped once the pending restore is uploaded
+	};
+
+	size_t levelBytes(const Entry& entry, unsigned int first) const;
+	bool canDrop(const Entry& entry, unsigned int dropped) const;
+	void evict(unsigned int textureID, Entry& entry, unsigned int dropped);
+	void finishRestore(unsigned int textureID, Entry& entry);
+
+	std::unordered_map<unsigned int, Entry> entries;
+	size_t budgetBytes = 0;
+	unsigned int minIdleFrames = 120;
+	int minResidentSize = 64;
+	uint64_t frame = 1;
+	size_t residentBytes = 0;
+	size_t reservedBytes = 0;			// what pending restores will add
+	TextureResidencyStats counters;
+};
+
+#endif
@@ -0,0 +1,75 @@
+#include "transform_graph.h"
+
+#include <algorithm>
+#include <iostream>
+
+void TransformGraph::reserve(size_t count) {
+	parents.reserve(count);
+	subtreeEnds.reserve(count);
+	locals.reserve(count);
+	worlds.reserve(count);
+	dirtyFlags.reserve(count);
+}
+
+void TransformGraph::clear() {
+	parents.clear();
+	subtreeEnds.clear();
+	locals.clear();
+	worlds.clear();
+	dirtyFlags.clear();
+	firstDirty = 0;
+}
+
+int TransformGraph::addNode(int parent, const glm::mat4& local) {
+	int index = static_cast<int>(parents.size());
+
+	// a node added under anything but the open branch would split its parent's range
+	if (parent != TRANSFORM_NONE && (parent < 0 || parent >= index || subtreeEnds[parent] != index)) {
+		std::cout << "ERROR::TRANSFORM_GRAPH::NODE_NOT_DEPTH_FIRST " << parent << std::endl;
+		return -1;
+	}
+
+	parents.push_back(parent);
+	subtreeEnds.push_back(index + 1);
+	locals.push_back(local);
+	worlds.push_back(local);
+	dirtyFlags.push_back(1);
+	firstDirty = std::min(firstDirty, static_cast<size_t>(index));
+
+	for (int ancestor = parent; ancestor != TRANSFORM_NONE; ancestor = parents[ancestor]) {
+		subtreeEnds[ancestor] = index + 1;
+	}
+	return index;
+}
+
+void TransformGraph::setLocal(int node, const glm::mat4& local) {
+	locals[node] = local;
+	dirtyFlags[node] = 1;
+	firstDirty = std::min(firstDirty, static_cast<size_t>(node));
+}
+
+size_t TransformGraph::update() {
+	size_t count = parents.size();
+	size_t updated = 0;
+
+	size_t node = firstDirty;
+	while (node < count) {
+		if (!dirtyFlags[node]) {
+			node++;
+			continue;
+		}
+
+		// parents come first, the whole range can be rebuilt in order. Dirty nodes inside it are covered too
+		size_t end = static_cast<size_t>(subtreeEnds[node]);
+		for (size_t i = node; i < end; i++) {
+			int parent = parents[i];
+			worlds[i] = parent == TRANSFORM_NONE ? locals[i] : worlds[parent] * locals[i];
+			dirtyFlags[i] = 0;
+		}
+		updated += end - node;
+		node = end;
+	}
+
+	firstDirty = count;
+	return updated;
+}
@@ -0,0 +1,47 @@
+#ifndef TRANSFORM_GRAPH_H
+#define TRANSFORM_GRAPH_H
+
+#include <glm/glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define TRANSFORM_NONE -1
+
+// Node hierarchy of a model as flat arrays, parents before children. Nodes are added depth first
+// so every subtree is a contiguous range, update() recomputes the world matrices of the subtrees
+// whose local changed in one forward pass without following any pointers
+class TransformGraph {
+public:
+	void reserve(size_t count);
+	void clear();
+
+	// parent has to be TRANSFORM_NONE or the last added node or one of its ancestors, -1 otherwise
+	int addNode(int parent, const glm::mat4& local);
+
+	// marks the node's subtree for the next update()
+	void setLocal(int node, const glm::mat4& local);
+
+	// recompute the worlds of every changed subtree, returns the number of nodes recomputed
+	size_t update();
+
+	size_t size() const { return parents.size(); }
+	bool empty() const { return parents.empty(); }
+	bool dirty() const { return firstDirty < parents.size(); }
+
+	int parent(int node) const { return parents[node]; }
+	int subtreeEnd(int node) const { return subtreeEnds[node]; }	// one past the node's last descendant
+	const glm::mat4& local(int node) const { return locals[node]; }
+	const glm::mat4& world(int node) const { return worlds[node]; }	// as of the last update()
+
+private:
+	std::vector<int> parents;
+	std::vector<int> subtreeEnds;
+	std::vector<glm::mat4> locals;
+	std::vector<glm::mat4> worlds;
+	std::vector<uint8_t> dirtyFlags;	// set on the roots of the changed subtrees only
+	size_t firstDirty = 0;				// nothing before it needs an update
+};
+
+#endif
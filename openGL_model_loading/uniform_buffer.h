@@ -0,0 +1,94 @@
+#ifndef UNIFORM_BUFFER_H
+#define UNIFORM_BUFFER_H
+
+#include <glad/glad.h>
+
+#include <glm/glm/glm.hpp>
+
+#include "shader_class.h"
+
+#include <cstddef>
+#include <vector>
+
+// binding points of the shared blocks, 0 stays free for the model loader's BonePalette
+#define CAMERA_BLOCK_BINDING 1
+#define OBJECT_BLOCK_BINDING 2
+
+// frames the GPU may still be reading while the CPU writes the next one
+#define UNIFORM_RING_FRAMES 3
+
+// std140 layout of the Camera block every program declares
+struct CameraBlock {
+	glm::mat4 view;
+	glm::mat4 projection;
+	glm::vec4 position;		// w unused
+};
+
+// std140 layout of the Object block, one per draw
+struct ObjectBlock {
+	glm::mat4 model;
+	glm::mat4 normalMat;	// inverse transpose of model, a mat4 so it needs no std140 column padding
+};
+
+// point a program's Camera and Object blocks at their binding points, once after it is linked
+void bindUniformBlocks(const Shader& shader);
+
+// counters of the last frame
+struct UniformRingStats {
+	size_t bytes = 0;				// written this frame, padding included
+	unsigned int blocks = 0;
+	size_t capacity = 0;			// per frame
+	unsigned int orphaned = 0;		// 1 when this frame's region was still in use and the storage was replaced instead of waited on
+};
+
+// One uniform buffer split into a region per frame in flight. Blocks pushed during a frame are
+// staged on the CPU, written into the frame's region in one go by upload() and then bound with
+// glBindBufferRange for the draws that use them. A fence after each frame says when its region is
+// free again, the writes never wait on it. GL thread only
+class UniformRing {
+public:
+	// grows on its own when a frame needs more
+	explicit UniformRing(size_t bytesPerFrame = 64 * 1024);
+	~UniformRing();
+
+	UniformRing(const UniformRing&) = delete;
+	UniformRing& operator=(const UniformRing&) = delete;
+
+	// move to the next region and forget the staged blocks of the last frame
+	void beginFrame();
+
+	// stage a block, the offset is what bind takes
+	template <typename T>
+	size_t push(const T& block) { return push(&block, sizeof(T)); }
+	size_t push(const void* data, size_t bytes);
+
+	// write the staged blocks into the frame's region, once per frame before any draw that reads them is issued
+	void upload();
+
+	// bind a pushed block to a binding point, after upload
+	void bind(GLuint binding, size_t offset, size_t bytes) const;
+	template <typename T>
+	void bind(GLuint binding, size_t offset) const { bind(binding, offset, sizeof(T)); }
+
+	// fence the frame's region after its last draw
+	void endFrame();
+
+	const UniformRingStats& stats() const { return counters; }
+
+	// delete the buffer and fences while the context is still current, a ring that outlives
+	// glfwTerminate has to be released before it
+	void release();
+
+private:
+	void allocate(size_t bytesPerFrame);
+
+	GLuint buffer = 0;
+	size_t frameBytes = 0;
+	size_t alignment = 256;
+	unsigned int frame = 0;		// region being written
+	GLsync fences[UNIFORM_RING_FRAMES] = {};
+	std::vector<unsigned char> staging;
+	UniformRingStats counters;
+};
+
+#endif